@@ -129,7 +129,7 @@ FBA_INCLUDES := $(FBA_BURNER_DIR)/win32 \
 	$(FBA_GENERATED_DIR) \
 	$(FBA_LIB_DIR)
 
-COREFLAGS := -fno-stack-protector -DUSE_SPEEDHACKS -D__LIBRETRO_OPTIMIZATIONS__ -D__LIBRETRO__ -Wno-write-strings -DUSE_FILE32API -DANDROID -DFRONTEND_SUPPORTS_RGB565 -DWANT_NEOGEOCD
+COREFLAGS := -fno-stack-protector -DUSE_SPEEDHACKS -D__LIBRETRO_OPTIMIZATIONS__ -D__LIBRETRO__ -Wno-write-strings -DUSE_FILE32API -DANDROID -DFRONTEND_SUPPORTS_RGB565 -DWANT_NEOGEOCD -DHAVE_THREADS -DHAVE_MMAP
 COREFLAGS += -Wno-c++11-narrowing
 
 GIT_VERSION := " $(shell git rev-parse --short HEAD || echo unknown)"
@@ -139,7 +139,7 @@ endif
 
 include $(CLEAR_VARS)
 LOCAL_MODULE       := retro
-LOCAL_SRC_FILES    := $(filter-out $(BURN_BLACKLIST),$(foreach dir,$(FBA_SRC_DIRS),$(wildcard $(dir)/*.cpp))) $(filter-out $(BURN_BLACKLIST),$(foreach dir,$(FBA_SRC_DIRS),$(wildcard $(dir)/*.c))) $(LIBRETRO_DIR)/libretro.cpp $(LIBRETRO_DIR)/neocdlist.cpp $(LIBRETRO_DIR)/retro_common.cpp $(LIBRETRO_DIR)/retro_input.cpp
+LOCAL_SRC_FILES    := $(filter-out $(BURN_BLACKLIST),$(foreach dir,$(FBA_SRC_DIRS),$(wildcard $(dir)/*.cpp))) $(filter-out $(BURN_BLACKLIST),$(foreach dir,$(FBA_SRC_DIRS),$(wildcard $(dir)/*.c))) $(LIBRETRO_DIR)/libretro.cpp $(LIBRETRO_DIR)/neocdlist.cpp $(LIBRETRO_DIR)/retro_common.cpp $(LIBRETRO_DIR)/retro_input.cpp $(LIBRETRO_DIR)/retro_prefetch.cpp $(LIBRETRO_DIR)/retro_delta.cpp $(LIBRETRO_DIR)/retro_movie.cpp
 LOCAL_CXXFLAGS     := $(COREFLAGS)
 LOCAL_CFLAGS       := $(COREFLAGS)
 LOCAL_C_INCLUDES   := $(FBA_INCLUDES)
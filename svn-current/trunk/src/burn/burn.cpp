@@ -3,6 +3,7 @@
 #include "version.h"
 #include "burnint.h"
 #include "burn_sound.h"
+#include "burn_idle.h"
 #if defined(GEKKO) || defined(_XBOX1)
 #include "driverlist-gx.h"
 #elif defined(CPS1_ONLY)
@@ -76,11 +77,46 @@ bool BurnCheckMMXSupport()
 #endif
 }
 
+// Hash index of the driver short names, so a driver can be found without selecting each one in turn
+#define DRV_NAME_HASH_SIZE	(sizeof(pDriver) / sizeof(pDriver[0]) * 2 + 1)
+
+static UINT32 nBurnDrvNameHash[DRV_NAME_HASH_SIZE];	// Driver number + 1, or 0 for an empty slot
+
+static UINT32 BurnDrvNameHashSlot(const char* szName)
+{
+	UINT32 nHash = 2166136261U;
+
+	while (*szName) {
+		nHash = (nHash ^ (UINT8)*szName++) * 16777619U;
+	}
+
+	return nHash % DRV_NAME_HASH_SIZE;
+}
+
+static void BurnDrvNameHashInit()
+{
+	memset(nBurnDrvNameHash, 0, sizeof(nBurnDrvNameHash));
+
+	for (UINT32 i = 0; i < nBurnDrvCount; i++) {
+		UINT32 nSlot = BurnDrvNameHashSlot(pDriver[i]->szShortName);
+
+		while (nBurnDrvNameHash[nSlot]) {
+			if (++nSlot == DRV_NAME_HASH_SIZE) {
+				nSlot = 0;
+			}
+		}
+
+		nBurnDrvNameHash[nSlot] = i + 1;
+	}
+}
+
 extern "C" INT32 BurnLibInit()
 {
 	BurnLibExit();
 	nBurnDrvCount = sizeof(pDriver) / sizeof(pDriver[0]);	// count available drivers
 
+	BurnDrvNameHashInit();
+
 	cmc_4p_Precalc();
 	bBurnUseMMX = BurnCheckMMXSupport();
 
@@ -89,11 +125,34 @@ extern "C" INT32 BurnLibInit()
 
 extern "C" INT32 BurnLibExit()
 {
+	BurnParallelExit();
+
 	nBurnDrvCount = 0;
 
+	BurnDrvNameHashInit();
+
 	return 0;
 }
 
+// Get the number of the driver with the given short name, or ~0U if there isn't one.
+// Unlike selecting drivers and calling BurnDrvGetText(DRV_NAME), nBurnDrvActive isn't changed
+UINT32 BurnDrvFindByName(const char* szName)
+{
+	for (UINT32 nSlot = BurnDrvNameHashSlot(szName); nBurnDrvNameHash[nSlot]; ) {
+		UINT32 i = nBurnDrvNameHash[nSlot] - 1;
+
+		if (strcmp(pDriver[i]->szShortName, szName) == 0) {
+			return i;
+		}
+
+		if (++nSlot == DRV_NAME_HASH_SIZE) {
+			nSlot = 0;
+		}
+	}
+
+	return ~0U;
+}
+
 INT32 BurnGetZipName(char** pszName, UINT32 i)
 {
 	static char szFilename[MAX_PATH];
@@ -156,6 +215,7 @@ INT32 BurnGetZipName(char** pszName, UINT32 i)
 INT32 BurnStateMAMEScan(INT32 nAction, INT32* pnMin);
 void BurnStateExit();
 INT32 BurnStateInit();
+static void BurnAreaLayoutExit();
 
 // Get the text fields for the driver in TCHARs
 extern "C" TCHAR* BurnDrvGetText(UINT32 i)
@@ -618,7 +678,10 @@ extern "C" INT32 BurnDrvInit()
 	CheatInit();
 	HiscoreInit();
 	BurnStateInit();	
+	BurnAreaLayoutExit();
 	BurnInitMemoryManager();
+	BurnIdleInit();
+	BURN_PROF_RESET();
 
 	nReturnValue = pDriver[nBurnDrvActive]->Init();	// Forward to drivers function
 
@@ -659,6 +722,8 @@ extern "C" INT32 BurnDrvExit()
 	CheatSearchExit();
 	HiscoreExit();
 	BurnStateExit();
+	BurnAreaLayoutExit();
+	BurnIdleExit();
 	
 	nBurnCPUSpeedAdjust = 0x0100;
 	
@@ -712,7 +777,12 @@ extern "C" INT32 BurnDrvFrame()
 {
 	CheatApply();									// Apply cheats (if any)
 	HiscoreApply();
-	return pDriver[nBurnDrvActive]->Frame();		// Forward to drivers function
+
+	BURN_PROF_FRAME_START();
+	INT32 nRet = pDriver[nBurnDrvActive]->Frame();	// Forward to drivers function
+	BURN_PROF_FRAME_END();
+
+	return nRet;
 }
 
 // Force redraw of the screen
@@ -820,6 +890,9 @@ INT32 BurnByteswap(UINT8* pMem, INT32 nLen)
 // Application-defined rom loading function:
 INT32 (__cdecl *BurnExtLoadRom)(UINT8 *Dest, INT32 *pnWrote, INT32 i) = NULL;
 
+// Application-defined function giving the CRC and size of the file loaded for a rom:
+INT32 (__cdecl *BurnExtRomFileInfo)(INT32 i, UINT32* pnCrc, UINT32* pnLen) = NULL;
+
 // Application-defined colour conversion function
 static UINT32 __cdecl BurnHighColFiller(INT32, INT32, INT32, INT32) { return (UINT32)(~0); }
 UINT32 (__cdecl *BurnHighCol) (INT32 r, INT32 g, INT32 b, INT32 i) = BurnHighColFiller;
@@ -840,45 +913,109 @@ void BurnTransferClear()
 	memset((void*)pTransDraw, 0, nTransWidth * nTransHeight * sizeof(UINT16));
 }
 
+// Write a row of 24-bit pixels, packing 4 pixels into 3 words instead of storing 12 separate bytes
+static void BurnTransferRow24(UINT8* pDest, const UINT16* pSrc, const UINT32* pPalette, INT32 nWidth)
+{
+	INT32 x = 0;
+
+#ifndef MSB_FIRST
+	for (; x <= nWidth - 4; x += 4, pDest += 12) {
+		UINT32 c0 = pPalette[pSrc[x + 0]];
+		UINT32 c1 = pPalette[pSrc[x + 1]];
+		UINT32 c2 = pPalette[pSrc[x + 2]];
+		UINT32 c3 = pPalette[pSrc[x + 3]];
+		UINT32 w[3];
+
+		w[0] = (c0 & 0xffffff) | (c1 << 24);
+		w[1] = ((c1 >> 8) & 0xffff) | (c2 << 16);
+		w[2] = ((c2 >> 16) & 0xff) | (c3 << 8);
+
+		memcpy(pDest, w, 12);
+	}
+#endif
+
+	for (; x < nWidth; x++, pDest += 3) {
+		UINT32 c = pPalette[pSrc[x]];
+		pDest[0] = c & 0xFF;
+		pDest[1] = (c >> 8) & 0xFF;
+		pDest[2] = c >> 16;
+	}
+}
+
+static void BurnTransferRow16(UINT8* pDest, const UINT16* pSrc, const UINT32* pPalette, INT32 nWidth)
+{
+	UINT16* pPixel = (UINT16*)pDest;
+
+	for (INT32 x = 0; x < nWidth; x++) {
+		pPixel[x] = pPalette[pSrc[x]];
+	}
+}
+
+static void BurnTransferRow32(UINT8* pDest, const UINT16* pSrc, const UINT32* pPalette, INT32 nWidth)
+{
+	UINT32* pPixel = (UINT32*)pDest;
+
+	for (INT32 x = 0; x < nWidth; x++) {
+		pPixel[x] = pPalette[pSrc[x]];
+	}
+}
+
+// Screens this big (in pixels) are converted in bands on the worker threads,
+// smaller ones take less time than it takes to wake the workers
+#define TRANSFER_SPLIT_PIXELS	(640 * 480)
+#define TRANSFER_BANDS			(8)
+
+struct BurnTransferJob {
+	void (*pRow)(UINT8*, const UINT16*, const UINT32*, INT32);
+	const UINT32* pPalette;
+};
+
+static void BurnTransferBand(INT32 nBand, void* pParam)
+{
+	struct BurnTransferJob* pJob = (struct BurnTransferJob*)pParam;
+
+	INT32 nFirst = nTransHeight * nBand / TRANSFER_BANDS;
+	INT32 nLast = nTransHeight * (nBand + 1) / TRANSFER_BANDS;
+
+	const UINT16* pSrc = pTransDraw + nFirst * nTransWidth;
+	UINT8* pDest = pBurnDraw + nFirst * nBurnPitch;
+
+	for (INT32 y = nFirst; y < nLast; y++, pSrc += nTransWidth, pDest += nBurnPitch) {
+		pJob->pRow(pDest, pSrc, pJob->pPalette, nTransWidth);
+	}
+}
+
 INT32 BurnTransferCopy(UINT32* pPalette)
 {
 #if defined FBA_DEBUG
 	if (!Debug_BurnTransferInitted) bprintf(PRINT_ERROR, _T("BurnTransferCopy called without init\n"));
 #endif
 
-	UINT16* pSrc = pTransDraw;
-	UINT8* pDest = pBurnDraw;
-	
+	BURN_PROF_SCOPE(BURN_PROF_TRANSFER);
+
+	struct BurnTransferJob Job = { NULL, pPalette };
+
 	pBurnDrvPalette = pPalette;
 
 	switch (nBurnBpp) {
-		case 2: {
-			for (INT32 y = 0; y < nTransHeight; y++, pSrc += nTransWidth, pDest += nBurnPitch) {
-				for (INT32 x = 0; x < nTransWidth; x ++) {
-					((UINT16*)pDest)[x] = pPalette[pSrc[x]];
-				}
-			}
+		case 2:
+			Job.pRow = BurnTransferRow16;
 			break;
-		}
-		case 3: {
-			for (INT32 y = 0; y < nTransHeight; y++, pSrc += nTransWidth, pDest += nBurnPitch) {
-				for (INT32 x = 0; x < nTransWidth; x++) {
-					UINT32 c = pPalette[pSrc[x]];
-					*(pDest + (x * 3) + 0) = c & 0xFF;
-					*(pDest + (x * 3) + 1) = (c >> 8) & 0xFF;
-					*(pDest + (x * 3) + 2) = c >> 16;
-
-				}
-			}
+		case 3:
+			Job.pRow = BurnTransferRow24;
 			break;
-		}
-		case 4: {
-			for (INT32 y = 0; y < nTransHeight; y++, pSrc += nTransWidth, pDest += nBurnPitch) {
-				for (INT32 x = 0; x < nTransWidth; x++) {
-					((UINT32*)pDest)[x] = pPalette[pSrc[x]];
-				}
-			}
+		case 4:
+			Job.pRow = BurnTransferRow32;
 			break;
+		default:
+			return 0;
+	}
+
+	if (nTransWidth * nTransHeight >= TRANSFER_SPLIT_PIXELS) {
+		BurnParallel(TRANSFER_BANDS, BurnTransferBand, &Job);
+	} else {
+		for (INT32 nBand = 0; nBand < TRANSFER_BANDS; nBand++) {
+			BurnTransferBand(nBand, &Job);
 		}
 	}
 
@@ -933,6 +1070,11 @@ INT32 BurnAreaScan(INT32 nAction, INT32* pnMin)
 {
 	INT32 nRet = 0;
 
+	// A loop being watched for idling doesn't carry over into a loaded state
+	if (nAction & ACB_WRITE) {
+		BurnIdleReset();
+	}
+
 	// Handle any MAME-style variables
 	if (nAction & ACB_DRIVER_DATA) {
 		nRet = BurnStateMAMEScan(nAction, pnMin);
@@ -946,6 +1088,231 @@ INT32 BurnAreaScan(INT32 nAction, INT32* pnMin)
 	return nRet;
 }
 
+// ----------------------------------------------------------------------------
+// Savestate area layout
+
+// The sizes and names of the areas a full scan visits, so a savestate can be
+// sized, laid out and checked without running the driver's scan again. Data
+// pointers aren't kept: drivers are free to scan temporaries (see SCAN_OFF)
+static struct BurnArea* pAreaLayout = NULL;
+static INT32 nAreaLayoutCount = 0;
+static INT32 nAreaLayoutAlloc = 0;
+static UINT32 nAreaLayoutTotal = 0;
+static bool bAreaLayoutValid = false;
+
+static void BurnAreaLayoutFree()
+{
+	for (INT32 i = 0; i < nAreaLayoutCount; i++) {
+		free(pAreaLayout[i].szName);
+	}
+	nAreaLayoutCount = 0;
+	nAreaLayoutTotal = 0;
+}
+
+static INT32 __cdecl BurnAreaLayoutAcb(struct BurnArea* pba)
+{
+	if (nAreaLayoutCount >= nAreaLayoutAlloc) {
+		INT32 nNewAlloc = nAreaLayoutAlloc ? nAreaLayoutAlloc * 2 : 256;
+		struct BurnArea* pNew = (struct BurnArea*)realloc(pAreaLayout, nNewAlloc * sizeof(struct BurnArea));
+		if (pNew == NULL) {
+			return 1;
+		}
+		pAreaLayout = pNew;
+		nAreaLayoutAlloc = nNewAlloc;
+	}
+
+	struct BurnArea* pArea = &pAreaLayout[nAreaLayoutCount++];
+	pArea->Data = NULL;
+	pArea->nLen = pba->nLen;
+	pArea->nAddress = pba->nAddress;
+	pArea->szName = pba->szName ? strdup(pba->szName) : NULL;
+
+	nAreaLayoutTotal += pba->nLen;
+
+	return 0;
+}
+
+// Get the areas visited by a full read scan (ACB_FULLSCAN | ACB_READ), in scan
+// order. The list is recorded the first time and kept until it is invalidated.
+UINT32 BurnAreaLayout(struct BurnArea** ppArea, INT32* pnCount)
+{
+	if (!bAreaLayoutValid && nBurnDrvActive < nBurnDrvCount) {
+		INT32 (__cdecl *pAcb)(struct BurnArea* pba) = BurnAcb;
+
+		BurnAreaLayoutFree();
+
+		BurnAcb = BurnAreaLayoutAcb;
+		BurnAreaScan(ACB_FULLSCAN | ACB_READ, NULL);
+		BurnAcb = pAcb;
+
+		bAreaLayoutValid = true;
+	}
+
+	if (ppArea) {
+		*ppArea = pAreaLayout;
+	}
+	if (pnCount) {
+		*pnCount = nAreaLayoutCount;
+	}
+
+	return nAreaLayoutTotal;
+}
+
+// Make the next BurnAreaLayout() record the areas again. The layout is kept from the
+// first scan after the driver is initialised, so callers which find a scan no longer
+// matches it (BurnAreaSave()/BurnAreaLoad() failing) call this
+void BurnAreaLayoutInvalidate()
+{
+	bAreaLayoutValid = false;
+}
+
+static void BurnAreaLayoutExit()
+{
+	BurnAreaLayoutFree();
+
+	free(pAreaLayout);
+	pAreaLayout = NULL;
+	nAreaLayoutAlloc = 0;
+	bAreaLayoutValid = false;
+}
+
+// Bounded copies of the running machine's state to and from memory
+static UINT8* pAreaCopyPos = NULL;
+static UINT32 nAreaCopyLeft = 0;
+static bool bAreaCopyOverflow = false;
+
+static INT32 __cdecl BurnAreaSaveAcb(struct BurnArea* pba)
+{
+	if (bAreaCopyOverflow || pba->nLen > nAreaCopyLeft) {
+		bAreaCopyOverflow = true;
+		return 0;
+	}
+
+	memcpy(pAreaCopyPos, pba->Data, pba->nLen);
+	pAreaCopyPos += pba->nLen;
+	nAreaCopyLeft -= pba->nLen;
+
+	return 0;
+}
+
+static INT32 __cdecl BurnAreaLoadAcb(struct BurnArea* pba)
+{
+	// Nothing is copied once an area doesn't fit, as the rest would be misplaced
+	if (bAreaCopyOverflow || pba->nLen > nAreaCopyLeft) {
+		bAreaCopyOverflow = true;
+		return 0;
+	}
+
+	memcpy(pba->Data, pAreaCopyPos, pba->nLen);
+	pAreaCopyPos += pba->nLen;
+	nAreaCopyLeft -= pba->nLen;
+
+	return 0;
+}
+
+static INT32 BurnAreaCopy(UINT8* pState, UINT32 nLen, INT32 nAction)
+{
+	INT32 (__cdecl *pAcb)(struct BurnArea* pba) = BurnAcb;
+
+	pAreaCopyPos = pState;
+	nAreaCopyLeft = nLen;
+	bAreaCopyOverflow = false;
+
+	BurnAcb = (nAction & ACB_WRITE) ? BurnAreaLoadAcb : BurnAreaSaveAcb;
+	BurnAreaScan(ACB_FULLSCAN | nAction, NULL);
+	BurnAcb = pAcb;
+
+	return (bAreaCopyOverflow || nAreaCopyLeft) ? 1 : 0;
+}
+
+// Copy the running machine's state to memory, returns 1 if the areas scanned don't fill nLen bytes exactly
+INT32 BurnAreaSave(UINT8* pDest, UINT32 nLen)
+{
+	return BurnAreaCopy(pDest, nLen, ACB_READ);
+}
+
+// Load the running machine's state from memory, returns 1 if the areas scanned don't take nLen bytes
+// exactly. The machine is then left partly loaded, callers have to put it back in a known state.
+INT32 BurnAreaLoad(const UINT8* pSrc, UINT32 nLen)
+{
+	return BurnAreaCopy((UINT8*)pSrc, nLen, ACB_WRITE);
+}
+
+// ----------------------------------------------------------------------------
+// Machine instances
+
+// Drivers keep their state in globals, so only one machine can run at a time.
+// Several copies of the active driver can still share its ROMs and decoded
+// graphics by swapping the running machine's state in and out between frames.
+struct BurnInstance { UINT8* pState; UINT32 nLen; };
+
+// Make a new instance holding the state of the running machine
+struct BurnInstance* BurnInstanceCreate()
+{
+	if (nBurnDrvActive >= nBurnDrvCount) {
+		return NULL;
+	}
+
+	struct BurnInstance* pInstance = (struct BurnInstance*)malloc(sizeof(struct BurnInstance));
+	if (pInstance == NULL) {
+		return NULL;
+	}
+
+	pInstance->nLen = BurnAreaLayout(NULL, NULL);
+	pInstance->pState = (UINT8*)malloc(pInstance->nLen ? pInstance->nLen : 1);
+	if (pInstance->pState == NULL) {
+		free(pInstance);
+		return NULL;
+	}
+
+	if (BurnInstanceSave(pInstance)) {
+		BurnInstanceFree(pInstance);
+		return NULL;
+	}
+
+	return pInstance;
+}
+
+// Store the state of the running machine in an instance
+INT32 BurnInstanceSave(struct BurnInstance* pInstance)
+{
+	if (pInstance == NULL || nBurnDrvActive >= nBurnDrvCount) {
+		return 1;
+	}
+
+	if (BurnAreaSave(pInstance->pState, pInstance->nLen)) {
+		bprintf(PRINT_ERROR, _T("*** Machine instance doesn't match the layout of the running driver\n"));
+		return 1;
+	}
+
+	return 0;
+}
+
+// Make an instance the running machine. The running machine's state is
+// overwritten, so save it to its own instance first if it's still needed.
+// If the layout changed the machine is left partly loaded.
+INT32 BurnInstanceLoad(struct BurnInstance* pInstance)
+{
+	if (pInstance == NULL || nBurnDrvActive >= nBurnDrvCount) {
+		return 1;
+	}
+
+	if (BurnAreaLoad(pInstance->pState, pInstance->nLen)) {
+		bprintf(PRINT_ERROR, _T("*** Machine instance doesn't match the layout of the running driver\n"));
+		return 1;
+	}
+
+	return 0;
+}
+
+void BurnInstanceFree(struct BurnInstance* pInstance)
+{
+	if (pInstance) {
+		free(pInstance->pState);
+		free(pInstance);
+	}
+}
+
 // ----------------------------------------------------------------------------
 // Wrappers for MAME-specific function calls
 
@@ -975,50 +1342,53 @@ void logerror(char* szFormat, ...)
 // ----------------------------------------------------------------------------
 // Wrapper for MAME state_save_register_* calls
 
-struct BurnStateEntry { BurnStateEntry* pNext; BurnStateEntry* pPrev; char szName[256]; void* pValue; UINT32 nSize; };
+// Kept in a flat table rather than a list, since it's walked on every scan
+struct BurnStateEntry { void* pValue; UINT32 nSize; char* szName; };
 
-static BurnStateEntry* pStateEntryAnchor = NULL;
+static BurnStateEntry* pStateEntry = NULL;
+static INT32 nStateEntryCount = 0;
+static INT32 nStateEntryAlloc = 0;
 typedef void (*BurnPostloadFunction)();
 static BurnPostloadFunction BurnPostload[8];
 
 static void BurnStateRegister(const char* module, INT32 instance, const char* name, void* val, UINT32 size)
 {
-	// Allocate new node
-	BurnStateEntry* pNewEntry = (BurnStateEntry*)malloc(sizeof(BurnStateEntry));
-	if (pNewEntry == NULL) {
-		return;
+	char szName[256];
+
+	if (nStateEntryCount >= nStateEntryAlloc) {
+		INT32 nNewAlloc = nStateEntryAlloc ? nStateEntryAlloc * 2 : 64;
+		BurnStateEntry* pNew = (BurnStateEntry*)realloc(pStateEntry, nNewAlloc * sizeof(BurnStateEntry));
+		if (pNew == NULL) {
+			return;
+		}
+		pStateEntry = pNew;
+		nStateEntryAlloc = nNewAlloc;
 	}
 
-	memset(pNewEntry, 0, sizeof(BurnStateEntry));
+	snprintf(szName, sizeof(szName), "%s:%s %i", module, name, instance);
 
-	// Link the new node
-	pNewEntry->pNext = pStateEntryAnchor;
-	if (pStateEntryAnchor) {
-		pStateEntryAnchor->pPrev = pNewEntry;
+	BurnStateEntry* pNewEntry = &pStateEntry[nStateEntryCount];
+	pNewEntry->szName = strdup(szName);
+	if (pNewEntry->szName == NULL) {
+		return;
 	}
-	pStateEntryAnchor = pNewEntry;
-
-	sprintf(pNewEntry->szName, "%s:%s %i", module, name, instance);
 
 	pNewEntry->pValue = val;
 	pNewEntry->nSize = size;
+
+	nStateEntryCount++;
 }
 
 void BurnStateExit()
 {
-	if (pStateEntryAnchor) {
-		BurnStateEntry* pCurrentEntry = pStateEntryAnchor;
-		BurnStateEntry* pNextEntry;
-
-		do {
-			pNextEntry = pCurrentEntry->pNext;
-			if (pCurrentEntry) {
-				free(pCurrentEntry);
-			}
-		} while ((pCurrentEntry = pNextEntry) != 0);
+	for (INT32 i = 0; i < nStateEntryCount; i++) {
+		free(pStateEntry[i].szName);
 	}
 
-	pStateEntryAnchor = NULL;
+	free(pStateEntry);
+	pStateEntry = NULL;
+	nStateEntryCount = 0;
+	nStateEntryAlloc = 0;
 
 	for (INT32 i = 0; i < 8; i++) {
 		BurnPostload[i] = NULL;
@@ -1040,18 +1410,15 @@ INT32 BurnStateMAMEScan(INT32 nAction, INT32* pnMin)
 			*pnMin = 0x029418;
 		}
 
-		if (pStateEntryAnchor) {
+		// Newest registration first, the order the savestate format has always used
+		for (INT32 i = nStateEntryCount - 1; i >= 0; i--) {
 			struct BurnArea ba;
-			BurnStateEntry* pCurrentEntry = pStateEntryAnchor;
-
-			do {
-			   	ba.Data		= pCurrentEntry->pValue;
-				ba.nLen		= pCurrentEntry->nSize;
-				ba.nAddress = 0;
-				ba.szName	= pCurrentEntry->szName;
-				BurnAcb(&ba);
 
-			} while ((pCurrentEntry = pCurrentEntry->pNext) != 0);
+			ba.Data		= pStateEntry[i].pValue;
+			ba.nLen		= pStateEntry[i].nSize;
+			ba.nAddress = 0;
+			ba.szName	= pStateEntry[i].szName;
+			BurnAcb(&ba);
 		}
 
 		if (nAction & ACB_WRITE) {
@@ -28,6 +28,7 @@
 
 extern TCHAR szAppHiscorePath[MAX_PATH];
 extern TCHAR szAppSamplesPath[MAX_PATH];
+extern TCHAR szAppGfxCachePath[MAX_PATH];	// Where drivers may cache decoded graphics, empty to disable
 
 // Enable the MAME logerror() function in debug builds
 // #define MAME_USE_LOGERROR
@@ -96,6 +97,10 @@ enum BurnCartrigeCommand { CART_INIT_START, CART_INIT_END, CART_EXIT };
 // Application-defined rom loading function
 extern INT32 (__cdecl *BurnExtLoadRom)(UINT8* Dest, INT32* pnWrote, INT32 i);
 
+// Application-defined function giving the CRC and size of the file loaded for rom i, which can
+// differ from the driver's rom info. Returns 1 if no file is loaded for it.
+extern INT32 (__cdecl *BurnExtRomFileInfo)(INT32 i, UINT32* pnCrc, UINT32* pnLen);
+
 // Application-defined progress indicator functions
 extern INT32 (__cdecl *BurnExtProgressRangeCallback)(double dProgressRange);
 extern INT32 (__cdecl *BurnExtProgressUpdateCallback)(double dProgress, const TCHAR* pszText, bool bAbs);
@@ -261,6 +266,8 @@ void BurnLocalisationSetName(char *szName, TCHAR *szLongName);
 TCHAR* BurnDrvGetText(UINT32 i);
 char* BurnDrvGetTextA(UINT32 i);
 
+UINT32 BurnDrvFindByName(const char* szName);
+
 INT32 BurnDrvGetZipName(char** pszName, UINT32 i);
 INT32 BurnDrvGetRomInfo(struct BurnRomInfo *pri, UINT32 i);
 INT32 BurnDrvGetRomName(char** pszName, UINT32 i, INT32 nAka);
@@ -0,0 +1,213 @@
+// Idle loop detection
+
+#include "burnint.h"
+#include "burn_idle.h"
+
+#define IDLE_MAX_LOOPS		(64)	// Loops kept for each game, listed and found
+#define IDLE_MAX_REGS		(128)	// Bytes of registers compared between passes
+#define IDLE_PASSES			(2)		// Identical passes needed before a loop counts as idle
+
+INT32 nBurnIdleMode = BURN_IDLE_LISTED;
+INT32 nBurnIdleActive = 0;
+UINT32 nBurnIdleWrites = 0;
+
+struct IdleLoop {
+	INT32 nCpu;
+	UINT32 nHead;					// Any address in the loop for listed loops
+	UINT32 nBranch;					// Zero for listed loops
+	UINT32 nHits;
+};
+
+// Known idle loops, by driver or parent name, with the address of an instruction in
+// the loop. Use BURN_IDLE_REPORT to find candidates. Listed loops are skipped unless
+// the option turns idle skipping off, so they stand in for hand-written speedups
+static const struct {
+	const char* szName;
+	INT32 nCpu;
+	UINT32 nAddress;
+} IdleList[] = {
+	// CPS-3 games polling a flag in RAM which an interrupt sets
+	{ "sfiii",		BURN_IDLE_CPU_SH2,	0x06000882 },
+	{ "sfiii2",		BURN_IDLE_CPU_SH2,	0x06000882 },
+	{ "sfiii3",		BURN_IDLE_CPU_SH2,	0x06000882 },
+	{ "jojo",		BURN_IDLE_CPU_SH2,	0x0600065a },
+	{ "jojoba",		BURN_IDLE_CPU_SH2,	0x0600065a },
+	{ "redearth",	BURN_IDLE_CPU_SH2,	0x0600194c },
+
+	{ NULL,		0,		0 }
+};
+
+static struct IdleLoop IdleLoops[IDLE_MAX_LOOPS];
+static INT32 nIdleLoops = 0;
+static INT32 nIdleListed = 0;		// The listed loops come first
+
+// The loop being watched
+static INT32 nWatchCpu = -1;
+static UINT32 nWatchHead;
+static UINT32 nWatchBranch;
+static UINT32 nWatchWrites;
+static INT32 nWatchPasses;
+static UINT8 WatchRegs[IDLE_MAX_REGS];
+
+static void IdleUpdateActive()
+{
+	nBurnIdleActive = (nBurnIdleMode & (BURN_IDLE_DETECT | BURN_IDLE_REPORT)) || (nIdleListed && (nBurnIdleMode & BURN_IDLE_LISTED));
+}
+
+static const char* IdleCpuName(INT32 nCpu)
+{
+	switch (nCpu & ~0xff) {
+		case BURN_IDLE_CPU_M68K:	return "68000";
+		case BURN_IDLE_CPU_Z80:		return "Z80";
+		case BURN_IDLE_CPU_SH2:		return "SH-2";
+	}
+
+	return "cpu";
+}
+
+static struct IdleLoop* IdleFind(INT32 nCpu, UINT32 nHead, UINT32 nBranch, INT32 nFirst, INT32 nLast)
+{
+	for (INT32 i = nFirst; i < nLast; i++) {
+		if (IdleLoops[i].nCpu != nCpu) {
+			continue;
+		}
+		if (IdleLoops[i].nBranch ? (IdleLoops[i].nHead == nHead && IdleLoops[i].nBranch == nBranch) : (IdleLoops[i].nHead >= nHead && IdleLoops[i].nHead <= nBranch)) {
+			return &IdleLoops[i];
+		}
+	}
+
+	return NULL;
+}
+
+void BurnIdleAdd(INT32 nCpu, UINT32 nAddress)
+{
+	if (nIdleListed >= IDLE_MAX_LOOPS || IdleFind(nCpu, nAddress, nAddress, 0, nIdleListed)) {
+		return;
+	}
+
+	// Found loops are only kept for the report, drop them so the listed ones stay first
+	nIdleLoops = nIdleListed;
+
+	IdleLoops[nIdleListed].nCpu = nCpu;
+	IdleLoops[nIdleListed].nHead = nAddress;
+	IdleLoops[nIdleListed].nBranch = 0;
+	IdleLoops[nIdleListed].nHits = 0;
+
+	nIdleListed++;
+	nIdleLoops++;
+
+	IdleUpdateActive();
+}
+
+void BurnIdleReset()
+{
+	nWatchCpu = -1;
+}
+
+void BurnIdleSetMode(INT32 nMode)
+{
+	nBurnIdleMode = nMode;
+
+	BurnIdleReset();
+	IdleUpdateActive();
+}
+
+void BurnIdleInit()
+{
+	nIdleLoops = 0;
+	nIdleListed = 0;
+	nBurnIdleWrites = 0;
+
+	BurnIdleReset();
+
+	const char* szName = BurnDrvGetTextA(DRV_NAME);
+	const char* szParent = BurnDrvGetTextA(DRV_PARENT);
+
+	for (INT32 i = 0; IdleList[i].szName; i++) {
+		if (!strcmp(IdleList[i].szName, szName) || (szParent && !strcmp(IdleList[i].szName, szParent))) {
+			BurnIdleAdd(IdleList[i].nCpu, IdleList[i].nAddress);
+		}
+	}
+
+	IdleUpdateActive();
+}
+
+void BurnIdleExit()
+{
+	if (nBurnIdleMode & BURN_IDLE_REPORT) {
+		for (INT32 i = 0; i < nIdleLoops; i++) {
+			if (IdleLoops[i].nBranch) {
+				bprintf(PRINT_NORMAL, _T("Idle loop: %hs #%d 0x%08X-0x%08X, %u hits\n"), IdleCpuName(IdleLoops[i].nCpu), IdleLoops[i].nCpu & 0xff, IdleLoops[i].nHead, IdleLoops[i].nBranch, IdleLoops[i].nHits);
+			} else {
+				bprintf(PRINT_NORMAL, _T("Idle loop: %hs #%d 0x%08X (listed), %u hits\n"), IdleCpuName(IdleLoops[i].nCpu), IdleLoops[i].nCpu & 0xff, IdleLoops[i].nHead, IdleLoops[i].nHits);
+			}
+		}
+	}
+
+	nIdleLoops = 0;
+	nIdleListed = 0;
+
+	BurnIdleReset();
+	IdleUpdateActive();
+}
+
+INT32 BurnIdleCheck(INT32 nCpu, UINT32 nHead, UINT32 nBranch, const void* pRegs, INT32 nRegsLen)
+{
+	struct IdleLoop* pListed = NULL;
+
+	if (nIdleListed && (nBurnIdleMode & BURN_IDLE_LISTED)) {
+		pListed = IdleFind(nCpu, nHead, nBranch, 0, nIdleListed);
+	}
+
+	if ((pListed == NULL && (nBurnIdleMode & (BURN_IDLE_DETECT | BURN_IDLE_REPORT)) == 0) || nRegsLen > IDLE_MAX_REGS) {
+		return 0;
+	}
+
+	if (nCpu != nWatchCpu || nHead != nWatchHead || nBranch != nWatchBranch || nBurnIdleWrites != nWatchWrites) {
+		// Start watching this loop, the registers are only kept once a pass
+		// writes nothing, so busy loops stay cheap
+		nWatchCpu = nCpu;
+		nWatchHead = nHead;
+		nWatchBranch = nBranch;
+		nWatchWrites = nBurnIdleWrites;
+		nWatchPasses = -1;
+
+		return 0;
+	}
+
+	if (nWatchPasses < 0 || memcmp(WatchRegs, pRegs, nRegsLen)) {
+		nWatchPasses = 0;
+		memcpy(WatchRegs, pRegs, nRegsLen);
+
+		return 0;
+	}
+
+	if (++nWatchPasses < IDLE_PASSES) {
+		return 0;
+	}
+
+	nWatchCpu = -1;
+
+	if (pListed) {
+		pListed->nHits++;
+		return 1;
+	}
+
+	struct IdleLoop* pLoop = IdleFind(nCpu, nHead, nBranch, nIdleListed, nIdleLoops);
+	if (pLoop == NULL && nIdleLoops < IDLE_MAX_LOOPS) {
+		pLoop = &IdleLoops[nIdleLoops++];
+		pLoop->nCpu = nCpu;
+		pLoop->nHead = nHead;
+		pLoop->nBranch = nBranch;
+		pLoop->nHits = 0;
+
+		if (nBurnIdleMode & BURN_IDLE_REPORT) {
+			bprintf(PRINT_NORMAL, _T("Idle loop found: %hs #%d 0x%08X-0x%08X\n"), IdleCpuName(nCpu), nCpu & 0xff, nHead, nBranch);
+		}
+	}
+	if (pLoop) {
+		pLoop->nHits++;
+	}
+
+	return (nBurnIdleMode & BURN_IDLE_DETECT) ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+#ifndef _BURN_IDLE_H
+#define _BURN_IDLE_H
+
+// Idle loop detection
+
+// A short backward branch whose loop ran again with the same registers and
+// no memory writes can only be waiting for something outside the cpu (an
+// interrupt, another cpu or a sound chip), so the rest of the timeslice can
+// be burned. The cpu cores call BurnIdleCheck() on such branches, listed loops
+// included, so a listed loop is only skipped once it's seen to be idle.
+
+#define BURN_IDLE_LISTED	(1)		// Skip the loops listed for the game
+#define BURN_IDLE_DETECT	(2)		// Skip any loop found to be idle
+#define BURN_IDLE_REPORT	(4)		// Log the idle loops found while running
+
+#define BURN_IDLE_CPU_M68K	(0x000)	// Cpu type, or'd with the cpu number
+#define BURN_IDLE_CPU_Z80	(0x100)
+#define BURN_IDLE_CPU_SH2	(0x200)
+
+#define BURN_IDLE_LOOP_MAX	(0x20)	// Longest loop (in bytes) the cores check
+
+extern "C" INT32 nBurnIdleMode;		// Set with BurnIdleSetMode()
+extern "C" INT32 nBurnIdleActive;	// Non-zero when the running game has loops to check
+extern "C" UINT32 nBurnIdleWrites;	// Incremented by the cores on every memory write, while active
+
+#define BURN_IDLE_WRITE()	do { if (nBurnIdleActive) nBurnIdleWrites++; } while (0)
+
+void BurnIdleInit();
+void BurnIdleExit();
+void BurnIdleReset();
+void BurnIdleSetMode(INT32 nMode);
+
+// Drivers can list known idle loops (the address of any instruction in the loop) in their init
+void BurnIdleAdd(INT32 nCpu, UINT32 nAddress);
+
+// Returns 1 if the cpu should burn the rest of its timeslice
+INT32 BurnIdleCheck(INT32 nCpu, UINT32 nHead, UINT32 nBranch, const void* pRegs, INT32 nRegsLen);
+
+#endif
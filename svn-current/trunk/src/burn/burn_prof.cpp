@@ -0,0 +1,241 @@
+// Frame time profiling
+
+#include "burnint.h"
+
+#ifdef FBA_PROFILE
+
+#if defined (_WIN32)
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+#define PROF_MAX_DEPTH		(16)
+
+static const char* SectionNames[BURN_PROF_SECTIONS] = {
+	"other", "m68k", "z80", "sh2", "sound_fm", "sound_pcm", "sound_psg", "draw", "transfer"
+};
+
+static UINT32 ProfRing[BURN_PROF_FRAMES][BURN_PROF_SECTIONS];	// Nanoseconds
+static UINT32 nProfFrames = 0;
+
+static UINT64 ProfTicks[BURN_PROF_SECTIONS];					// The frame being timed
+static UINT64 nProfLast;
+static double dProfNsPerTick;
+
+static INT32 nProfSection = BURN_PROF_OTHER;
+static INT32 ProfStack[PROF_MAX_DEPTH];
+static INT32 nProfDepth = 0;
+static bool bProfSuspended = false;
+
+static inline UINT64 ProfClock()
+{
+#if defined (_WIN32)
+	LARGE_INTEGER nCount;
+	QueryPerformanceCounter(&nCount);
+	return nCount.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (UINT64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+void BurnProfEnter(INT32 nSection)
+{
+	UINT64 nNow = ProfClock();
+
+	ProfTicks[nProfSection] += nNow - nProfLast;
+	nProfLast = nNow;
+
+	// Sections nested too deep are left to their parent
+	if (nProfDepth < PROF_MAX_DEPTH) {
+		ProfStack[nProfDepth] = nProfSection;
+		nProfSection = nSection;
+	}
+	nProfDepth++;
+}
+
+void BurnProfLeave()
+{
+	UINT64 nNow = ProfClock();
+
+	ProfTicks[nProfSection] += nNow - nProfLast;
+	nProfLast = nNow;
+
+	if (nProfDepth == 0) {
+		return;
+	}
+
+	nProfDepth--;
+	if (nProfDepth < PROF_MAX_DEPTH) {
+		nProfSection = ProfStack[nProfDepth];
+	}
+}
+
+void BurnProfReset()
+{
+#if defined (_WIN32)
+	LARGE_INTEGER nFreq;
+	QueryPerformanceFrequency(&nFreq);
+	dProfNsPerTick = 1000000000.0 / nFreq.QuadPart;
+#else
+	dProfNsPerTick = 1.0;
+#endif
+
+	memset(ProfRing, 0, sizeof(ProfRing));
+	nProfFrames = 0;
+	bProfSuspended = false;
+}
+
+void BurnProfSuspend(INT32 bSuspend)
+{
+	bProfSuspended = bSuspend ? true : false;
+}
+
+void BurnProfFrameStart()
+{
+	if (bProfSuspended) {
+		return;
+	}
+
+	memset(ProfTicks, 0, sizeof(ProfTicks));
+
+	nProfSection = BURN_PROF_OTHER;
+	nProfDepth = 0;
+	nProfLast = ProfClock();
+}
+
+void BurnProfFrameEnd()
+{
+	if (bProfSuspended) {
+		return;
+	}
+
+	UINT32* pFrame = ProfRing[nProfFrames % BURN_PROF_FRAMES];
+
+	ProfTicks[nProfSection] += ProfClock() - nProfLast;
+
+	for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+		pFrame[i] = (UINT32)(ProfTicks[i] * dProfNsPerTick);
+	}
+
+	nProfFrames++;
+}
+
+UINT32 BurnProfFrames()
+{
+	return nProfFrames;
+}
+
+INT32 BurnProfGetStats(double* pfMean, double* pfMax)
+{
+	INT32 nFrames = (nProfFrames < BURN_PROF_FRAMES) ? nProfFrames : BURN_PROF_FRAMES;
+
+	for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+		UINT64 nTotal = 0;
+		UINT32 nMax = 0;
+
+		for (INT32 f = 0; f < nFrames; f++) {
+			nTotal += ProfRing[f][i];
+			if (ProfRing[f][i] > nMax) {
+				nMax = ProfRing[f][i];
+			}
+		}
+
+		if (pfMean) {
+			pfMean[i] = nFrames ? nTotal / 1000.0 / nFrames : 0.0;
+		}
+		if (pfMax) {
+			pfMax[i] = nMax / 1000.0;
+		}
+	}
+
+	return nFrames;
+}
+
+const char* BurnProfSectionName(INT32 nSection)
+{
+	if (nSection < 0 || nSection >= BURN_PROF_SECTIONS) {
+		return NULL;
+	}
+
+	return SectionNames[nSection];
+}
+
+void BurnProfReport()
+{
+	double fMean[BURN_PROF_SECTIONS], fMax[BURN_PROF_SECTIONS];
+	double fTotal = 0.0;
+
+	INT32 nFrames = BurnProfGetStats(fMean, fMax);
+	if (nFrames == 0) {
+		return;
+	}
+
+	for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+		fTotal += fMean[i];
+	}
+
+	bprintf(PRINT_UI, _T("Profile of the last %i frames, %.1f us per frame:\n"), nFrames, fTotal);
+
+	for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+		if (fMax[i] > 0.0) {
+			bprintf(PRINT_UI, _T("  %-10hs mean %9.1f us (%4.1f%%), max %9.1f us\n"), SectionNames[i], fMean[i], fMean[i] * 100.0 / fTotal, fMax[i]);
+		}
+	}
+}
+
+INT32 BurnProfDump(const TCHAR* szFilename, INT32 nFormat)
+{
+	FILE* fp = _tfopen(szFilename, _T("w"));
+	if (fp == NULL) {
+		return 1;
+	}
+
+	INT32 nFrames = (nProfFrames < BURN_PROF_FRAMES) ? nProfFrames : BURN_PROF_FRAMES;
+	UINT32 nFirst = nProfFrames - nFrames;
+
+	if (nFormat == BURN_PROF_JSON) {
+		fprintf(fp, "{\n\t\"game\": \"%s\",\n\t\"unit\": \"ns\",\n\t\"sections\": [", BurnDrvGetTextA(DRV_NAME));
+		for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+			fprintf(fp, "%s\"%s\"", i ? ", " : "", SectionNames[i]);
+		}
+		fprintf(fp, "],\n\t\"first_frame\": %u,\n\t\"frames\": [\n", nFirst);
+	} else {
+		fprintf(fp, "frame");
+		for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+			fprintf(fp, ",%s", SectionNames[i]);
+		}
+		fprintf(fp, "\n");
+	}
+
+	// Oldest frame first
+	for (INT32 f = 0; f < nFrames; f++) {
+		UINT32* pFrame = ProfRing[(nFirst + f) % BURN_PROF_FRAMES];
+
+		if (nFormat == BURN_PROF_JSON) {
+			fprintf(fp, "\t\t[");
+			for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+				fprintf(fp, "%s%u", i ? ", " : "", pFrame[i]);
+			}
+			fprintf(fp, "]%s\n", (f < nFrames - 1) ? "," : "");
+		} else {
+			fprintf(fp, "%u", nFirst + f);
+			for (INT32 i = 0; i < BURN_PROF_SECTIONS; i++) {
+				fprintf(fp, ",%u", pFrame[i]);
+			}
+			fprintf(fp, "\n");
+		}
+	}
+
+	if (nFormat == BURN_PROF_JSON) {
+		fprintf(fp, "\t]\n}\n");
+	}
+
+	fclose(fp);
+
+	return 0;
+}
+
+#endif
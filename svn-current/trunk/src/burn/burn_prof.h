@@ -0,0 +1,90 @@
+#ifndef _BURN_PROF_H
+#define _BURN_PROF_H
+
+// Frame time profiling
+
+// Only built with FBA_PROFILE defined (make PROFILE=1), otherwise the macros
+// below are empty. Time is exclusive: a sound chip rendering from inside ZetRun()
+// counts as sound, not Z80, until it returns. BurnDrvFrame() starts and ends the
+// frames, and time inside it but outside any section counts as "other".
+
+enum BurnProfSection {
+	BURN_PROF_OTHER = 0,
+	BURN_PROF_M68K,
+	BURN_PROF_Z80,
+	BURN_PROF_SH2,
+	BURN_PROF_SOUND_FM,		// Yamaha FM chips, with their ADPCM parts
+	BURN_PROF_SOUND_PCM,	// Sample players (MSM6295, QSound, YMZ280B, uPD7759...)
+	BURN_PROF_SOUND_PSG,	// Tone generators (AY8910 and the FM chips' SSG, SN76496...)
+	BURN_PROF_DRAW,			// Driver video rendering
+	BURN_PROF_TRANSFER,		// BurnTransferCopy()
+	BURN_PROF_SECTIONS
+};
+
+#define BURN_PROF_FRAMES	(600)	// Frames kept in the ring buffer
+
+#define BURN_PROF_CSV		(0)
+#define BURN_PROF_JSON		(1)
+
+#ifdef FBA_PROFILE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void BurnProfEnter(INT32 nSection);
+void BurnProfLeave();
+#ifdef __cplusplus
+}
+
+// Times the rest of the enclosing block
+class BurnProfScope {
+public:
+	BurnProfScope(INT32 nSection) { BurnProfEnter(nSection); }
+	~BurnProfScope() { BurnProfLeave(); }
+};
+
+void BurnProfReset();
+void BurnProfFrameStart();
+void BurnProfFrameEnd();
+
+// Frames run while suspended (run-ahead replays...) aren't recorded
+void BurnProfSuspend(INT32 bSuspend);
+
+// Frames profiled since the last reset
+UINT32 BurnProfFrames();
+
+// Mean and worst time (in microseconds) of each section over the frames in the
+// ring buffer, either array can be NULL. Returns the number of frames used.
+INT32 BurnProfGetStats(double* pfMean, double* pfMax);
+
+const char* BurnProfSectionName(INT32 nSection);
+
+// Log the stats through bprintf()
+void BurnProfReport();
+
+// Write the frames in the ring buffer, one line (CSV) or array (JSON) per frame, in nanoseconds
+INT32 BurnProfDump(const TCHAR* szFilename, INT32 nFormat);
+
+#define BURN_PROF_SCOPE(s)		BurnProfScope BurnProfScope_(s)
+#endif
+
+#define BURN_PROF_ENTER(s)		BurnProfEnter(s)
+#define BURN_PROF_LEAVE()		BurnProfLeave()
+#define BURN_PROF_RESET()		BurnProfReset()
+#define BURN_PROF_FRAME_START()	BurnProfFrameStart()
+#define BURN_PROF_FRAME_END()	BurnProfFrameEnd()
+#define BURN_PROF_SUSPEND(b)	BurnProfSuspend(b)
+
+#else
+
+#define BURN_PROF_SCOPE(s)
+#define BURN_PROF_ENTER(s)
+#define BURN_PROF_LEAVE()
+#define BURN_PROF_RESET()
+#define BURN_PROF_FRAME_START()
+#define BURN_PROF_FRAME_END()
+#define BURN_PROF_SUSPEND(b)
+
+#endif
+
+#endif
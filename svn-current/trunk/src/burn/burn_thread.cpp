@@ -0,0 +1,149 @@
+// Worker threads for splitting up long jobs
+
+#include "burnint.h"
+
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#include <unistd.h>
+
+#define PARALLEL_MAX_THREADS	(8)		// Including the thread which starts the job
+
+static pthread_t ParallelThread[PARALLEL_MAX_THREADS];
+static INT32 nParallelThreads = 0;		// Workers running, the calling thread isn't counted
+static bool bParallelInit = false;
+
+static pthread_mutex_t ParallelCallLock = PTHREAD_MUTEX_INITIALIZER;	// Held for the whole of a job
+static pthread_mutex_t ParallelLock = PTHREAD_MUTEX_INITIALIZER;		// Guards the job below
+static pthread_cond_t ParallelStart = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t ParallelDone = PTHREAD_COND_INITIALIZER;
+
+static void (*pParallelWork)(INT32, void*) = NULL;
+static void* pParallelParam = NULL;
+static INT32 nParallelCount = 0;
+static INT32 nParallelNext = 0;			// Next index to hand out
+static INT32 nParallelBusy = 0;			// Workers which haven't finished the job yet
+static UINT32 nParallelJob = 0;			// Incremented for every job
+static bool bParallelQuit = false;
+
+// Run indexes until there are none left, called with ParallelLock held
+static void BurnParallelTake()
+{
+	while (nParallelNext < nParallelCount) {
+		INT32 i = nParallelNext++;
+
+		pthread_mutex_unlock(&ParallelLock);
+		pParallelWork(i, pParallelParam);
+		pthread_mutex_lock(&ParallelLock);
+	}
+}
+
+static void* BurnParallelWorker(void* pArg)
+{
+	UINT32 nJob = (UINT32)(uintptr_t)pArg;
+
+	pthread_mutex_lock(&ParallelLock);
+
+	for (;;) {
+		while (!bParallelQuit && nJob == nParallelJob) {
+			pthread_cond_wait(&ParallelStart, &ParallelLock);
+		}
+		if (bParallelQuit) {
+			break;
+		}
+
+		nJob = nParallelJob;
+		BurnParallelTake();
+
+		if (--nParallelBusy == 0) {
+			pthread_cond_signal(&ParallelDone);
+		}
+	}
+
+	pthread_mutex_unlock(&ParallelLock);
+
+	return NULL;
+}
+
+static void BurnParallelInit()
+{
+	INT32 nThreads = (INT32)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nThreads > PARALLEL_MAX_THREADS) {
+		nThreads = PARALLEL_MAX_THREADS;
+	}
+
+	bParallelInit = true;
+	bParallelQuit = false;
+	nParallelThreads = 0;
+
+	for (INT32 i = 1; i < nThreads; i++) {
+		if (pthread_create(&ParallelThread[nParallelThreads], NULL, BurnParallelWorker, (void*)(uintptr_t)nParallelJob)) {
+			break;
+		}
+		nParallelThreads++;
+	}
+}
+#endif
+
+void BurnParallel(INT32 nCount, void (*pWork)(INT32 nIndex, void* pParam), void* pParam)
+{
+#ifdef HAVE_THREADS
+	if (nCount > 1 && pthread_mutex_trylock(&ParallelCallLock) == 0) {
+		if (!bParallelInit) {
+			BurnParallelInit();
+		}
+
+		if (nParallelThreads) {
+			pthread_mutex_lock(&ParallelLock);
+
+			pParallelWork = pWork;
+			pParallelParam = pParam;
+			nParallelCount = nCount;
+			nParallelNext = 0;
+			nParallelBusy = nParallelThreads;
+			nParallelJob++;
+			pthread_cond_broadcast(&ParallelStart);
+
+			// This thread takes its share too
+			BurnParallelTake();
+
+			while (nParallelBusy) {
+				pthread_cond_wait(&ParallelDone, &ParallelLock);
+			}
+
+			pthread_mutex_unlock(&ParallelLock);
+			pthread_mutex_unlock(&ParallelCallLock);
+
+			return;
+		}
+
+		pthread_mutex_unlock(&ParallelCallLock);
+	}
+#endif
+
+	for (INT32 i = 0; i < nCount; i++) {
+		pWork(i, pParam);
+	}
+}
+
+void BurnParallelExit()
+{
+#ifdef HAVE_THREADS
+	pthread_mutex_lock(&ParallelCallLock);
+
+	if (bParallelInit) {
+		pthread_mutex_lock(&ParallelLock);
+		bParallelQuit = true;
+		pthread_cond_broadcast(&ParallelStart);
+		pthread_mutex_unlock(&ParallelLock);
+
+		for (INT32 i = 0; i < nParallelThreads; i++) {
+			pthread_join(ParallelThread[i], NULL);
+		}
+
+		nParallelThreads = 0;
+		bParallelInit = false;
+	}
+
+	pthread_mutex_unlock(&ParallelCallLock);
+#endif
+}
@@ -0,0 +1,17 @@
+#ifndef _BURN_THREAD_H
+#define _BURN_THREAD_H
+
+// Worker threads for splitting up long jobs (decoding and decrypting graphics...)
+
+// The workers are started by the first job and kept until BurnParallelExit().
+// Without HAVE_THREADS, or while another job is running (jobs started from a
+// job's own work function included), the work is done on the calling thread.
+
+// pWork is called once for every index in 0..nCount-1, in no particular order
+// and possibly from different threads, so the chunks must not overlap
+void BurnParallel(INT32 nCount, void (*pWork)(INT32 nIndex, void* pParam), void* pParam);
+
+// Stop the workers
+void BurnParallelExit();
+
+#endif
@@ -102,6 +102,12 @@ struct BurnDriver {
 // Standard functions for dealing with ROM and input info structures
 #include "stdfunc.h"
 
+// Frame time profiling
+#include "burn_prof.h"
+
+// Worker threads
+#include "burn_thread.h"
+
 // ---------------------------------------------------------------------------
 
 // burn.cpp
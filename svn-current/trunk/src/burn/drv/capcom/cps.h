@@ -158,6 +158,7 @@ extern INT32 bCpsUpdatePalEveryFrame;
 INT32 CpsPalInit();
 INT32 CpsPalExit();
 INT32 CpsPalUpdate(UINT8 *pNewPal);
+void CpsPalRecalc();
 
 // cps_mem.cpp
 extern UINT8 *CpsRam90;
@@ -492,6 +492,7 @@ static void DoDraw(INT32 Recalc)
 	CtvReady();								// Point to correct tile drawing functions
 
 	if (bCpsUpdatePalEveryFrame) GetPalette(0, 6);
+	if (Recalc) CpsPalRecalc();				// colour format may have changed, convert every colour
 	if (Recalc || bCpsUpdatePalEveryFrame) CpsPalUpdate(CpsSavePal);		// recalc whole palette if needed
 	
 	CpsClearScreen();
@@ -501,6 +502,8 @@ static void DoDraw(INT32 Recalc)
 
 INT32 CpsDraw()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	DoDraw(CpsRecalcPal);
 
 	CpsRecalcPal = 0;
@@ -509,6 +512,8 @@ INT32 CpsDraw()
 
 INT32 CpsRedraw()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	DoDraw(1);
 
 	CpsRecalcPal = 0;
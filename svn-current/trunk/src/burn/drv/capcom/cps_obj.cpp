@@ -32,6 +32,12 @@ struct ObjFrame {
 static INT32 nFrameCount = 0;
 static struct ObjFrame of[3];
 
+// CPS2 sprites sorted by level (in list order) once a frame, so each level range
+// only goes through its own sprites
+static UINT16 ObjLevelList[8][0x400];
+static INT32 nObjLevelCount[8];
+static INT32 nObjLevelNext[8];				// First sprite of each level not passed yet
+
 INT32 CpsObjInit()
 {
 	nMax = 0x100;				// CPS1 has 256 sprites
@@ -177,9 +183,33 @@ void CpsObjDrawInit()
 	nMaxZValue = nZOffset + 1;
 	nMaxZMask = nZOffset;
 
+	struct ObjFrame* pof = of + nGetNext;
+	UINT16* ps = (UINT16*)pof->Obj;
+
+	for (INT32 i = 0; i < 8; i++) {
+		nObjLevelCount[i] = 0;
+		nObjLevelNext[i] = 0;
+	}
+
+	for (INT32 i = 0; i < pof->nCount; i++, ps += 4) {
+		INT32 v = BURN_ENDIAN_SWAP_INT16(ps[0]) >> 13;
+		ObjLevelList[v][nObjLevelCount[v]++] = i;
+	}
+
 	return;
 }
 
+// Find the rows or columns of tiles of a sprite that are on the screen
+static void CpsObjVisible(INT32 nPos, INT32 nTiles, INT32 nScreen, INT32* pnFrom, INT32* pnTo)
+{
+	*pnFrom = (nPos <= -16) ? ((-16 - nPos) >> 4) + 1 : 0;
+	*pnTo = (nPos >= nScreen) ? -1 : (nScreen - 1 - nPos) >> 4;
+
+	if (*pnTo >= nTiles) {
+		*pnTo = nTiles - 1;
+	}
+}
+
 INT32 Cps1ObjDraw(INT32 nLevelFrom,INT32 nLevelTo)
 {
 	INT32 i; UINT16 *ps; INT32 nPsAdd;
@@ -204,7 +234,8 @@ INT32 Cps1ObjDraw(INT32 nLevelFrom,INT32 nLevelTo)
 
 	// Go through all the Objs
 	for (i=0; i<pof->nCount; i++,ps+=nPsAdd) {
-		INT32 x,y,n,a,bx,by,dx,dy; INT32 nFlip;
+		INT32 x,y,n,a,bx,by,dx,dy,ex,ey; INT32 nFlip;
+		INT32 exFrom,exTo,eyFrom,eyTo;
 
 		x = BURN_ENDIAN_SWAP_INT16(ps[0]); y = BURN_ENDIAN_SWAP_INT16(ps[1]); n = BURN_ENDIAN_SWAP_INT16(ps[2]); a = BURN_ENDIAN_SWAP_INT16(ps[3]);
 			
@@ -237,13 +268,17 @@ INT32 Cps1ObjDraw(INT32 nLevelFrom,INT32 nLevelTo)
 		}
 
 		nCpstFlip=nFlip;
-		for (dy=0;dy<by;dy++) {
-			for (dx=0;dx<bx;dx++) {
-				INT32 ex,ey;
-				if (nFlip&1) ex=(bx-dx-1);
-				else ex=dx;
-				if (nFlip&2) ey=(by-dy-1);
-				else ey=dy;
+
+		// Only go through the tiles on the screen
+		CpsObjVisible(x, bx, 384, &exFrom, &exTo);
+		CpsObjVisible(y, by, 224, &eyFrom, &eyTo);
+
+		for (ey=eyFrom;ey<=eyTo;ey++) {
+			for (ex=exFrom;ex<=exTo;ex++) {
+				if (nFlip&1) dx=(bx-ex-1);
+				else dx=ex;
+				if (nFlip&2) dy=(by-ey-1);
+				else dy=ey;
 
 				nCpstX=x+(ex<<4);
 				nCpstY=y+(ey<<4);
@@ -260,41 +295,55 @@ INT32 Cps1ObjDraw(INT32 nLevelFrom,INT32 nLevelTo)
 // Delay sprite drawing by one frame
 INT32 Cps2ObjDraw(INT32 nLevelFrom, INT32 nLevelTo)
 {
-	const INT32 nPsAdd = 4;
-
 	UINT16 *ps;
 	struct ObjFrame *pof;
 	CpstOneDoFn pCpstOne;
-	INT32 nCount;
+	INT32 nFirst, nMaskFrom, i, v;
 
 	bool bMask = 0;
 
 	// Draw the earliest frame we have in history
 	pof = of + nGetNext;
 
-	// Point to Obj list
-	ps = (UINT16*)pof->Obj + nPsAdd * (nMaxZValue - nZOffset - 1);
-	nCount = nZOffset + pof->nCount;
+	// Sprites before the last one drawn unmasked have been passed
+	nFirst = nMaxZValue - nZOffset - 1;
 
-	// Go through all the Objs
-	for (ZValue = (UINT16)nMaxZValue; ZValue <= nCount; ZValue++, ps += nPsAdd) {
-		INT32 x, y, n, a, bx, by, dx, dy;
-		INT32 nFlip;
-		INT32 v = BURN_ENDIAN_SWAP_INT16(ps[0]) >> 13;
+	// Sprites after the first enabled sprite from a higher level are masked
+	nMaskFrom = pof->nCount;
+	for (v = 0; v < 8; v++) {
+		while (nObjLevelNext[v] < nObjLevelCount[v] && ObjLevelList[v][nObjLevelNext[v]] < nFirst) {
+			nObjLevelNext[v]++;
+		}
 
-		if ((nSpriteEnable & (1 << v)) == 0) {
-			continue;
+		if (v > nLevelTo && (nSpriteEnable & (1 << v)) && nObjLevelNext[v] < nObjLevelCount[v]) {
+			if (ObjLevelList[v][nObjLevelNext[v]] < nMaskFrom) {
+				nMaskFrom = ObjLevelList[v][nObjLevelNext[v]];
+			}
 		}
+	}
 
-		// Check if sprite is between these levels
-		if (v > nLevelTo) {
-			bMask = 1;
-			continue;
+	// Go through the Objs between these levels, in list order
+	while (1) {
+		INT32 x, y, n, a, bx, by, dx, dy, ex, ey;
+		INT32 exFrom, exTo, eyFrom, eyTo;
+		INT32 nFlip;
+
+		i = pof->nCount;
+		for (INT32 l = nLevelFrom; l <= nLevelTo; l++) {
+			if ((nSpriteEnable & (1 << l)) && nObjLevelNext[l] < nObjLevelCount[l] && ObjLevelList[l][nObjLevelNext[l]] < i) {
+				i = ObjLevelList[l][nObjLevelNext[l]];
+				v = l;
+			}
 		}
-		if (v < nLevelFrom) {
-			continue;
+		if (i >= pof->nCount) {
+			break;
 		}
+		nObjLevelNext[v]++;
 
+		ps = (UINT16*)pof->Obj + (i << 2);
+		ZValue = (UINT16)(nZOffset + i + 1);
+
+		bMask = (i > nMaskFrom);
 		if (bMask) {
 			nMaxZMask = ZValue;
 		} else {
@@ -366,20 +415,23 @@ INT32 Cps2ObjDraw(INT32 nLevelFrom, INT32 nLevelTo)
 //		}
 
 		nCpstFlip = nFlip;
-		for (dy = 0; dy < by; dy++) {
-			for (dx = 0; dx < bx; dx++) {
-				INT32 ex, ey;
 
+		// Only go through the tiles on the screen
+		CpsObjVisible(x, bx, 384, &exFrom, &exTo);
+		CpsObjVisible(y, by, 224, &eyFrom, &eyTo);
+
+		for (ey = eyFrom; ey <= eyTo; ey++) {
+			for (ex = exFrom; ex <= exTo; ex++) {
 				if (nFlip & 1) {
-					ex = (bx - dx - 1);
+					dx = (bx - ex - 1);
 				} else {
-					ex = dx;
+					dx = ex;
 				}
 
 				if (nFlip & 2) {
-					ey = (by - dy - 1);
+					dy = (by - ey - 1);
 				} else {
-					ey = dy;
+					dy = ey;
 				}
 
 				nCpstX = x + (ex << 4);
@@ -4,10 +4,32 @@
 // CPS (palette)
 
 static UINT8* CpsPalSrc = NULL;			// Copy of current input palette
+static UINT32* CpsPalLookup = NULL;		// Hicolor value for every possible palette word
+static INT32 nCpsPalLastCtrl = -1;		// Page enable bits of the last update, -1 to convert everything
+static INT32 nCpsPalLookupBpp = 0;		// Colour format CpsPalLookup was built for
+static UINT32 (__cdecl *CpsPalLookupHighCol) (INT32 r, INT32 g, INT32 b, INT32 i) = NULL;
 UINT32* CpsPal = NULL;					// Hicolor version of palette
 INT32 nCpsPalCtrlReg;
 INT32 bCpsUpdatePalEveryFrame = 0;		// Some of the hacks need this as they don't write to CpsReg 0x0a
 
+static void CpsPalLookupInit()
+{
+	for (INT32 Palette = 0; Palette < 0x10000; Palette++) {
+		INT32 r, g, b, Bright;
+
+		Bright = 0x0f + ((Palette >> 12) << 1);
+
+		r = ((Palette >> 8) & 0x0f) * 0x11 * Bright / 0x2d;
+		g = ((Palette >> 4) & 0x0f) * 0x11 * Bright / 0x2d;
+		b = ((Palette >> 0) & 0x0f) * 0x11 * Bright / 0x2d;
+
+		CpsPalLookup[Palette] = BurnHighCol(r, g, b, 0);
+	}
+
+	nCpsPalLookupBpp = nBurnBpp;
+	CpsPalLookupHighCol = BurnHighCol;
+}
+
 INT32 CpsPalInit()
 {
 	INT32 nLen = 0;
@@ -25,17 +47,37 @@ INT32 CpsPalInit()
 		return 1;
 	}
 
+	nLen = 0x10000 * sizeof(UINT32);
+	CpsPalLookup = (UINT32*)BurnMalloc(nLen);
+	if (CpsPalLookup == NULL) {
+		return 1;
+	}
+	CpsPalLookupInit();
+
+	nCpsPalLastCtrl = -1;
+
 	return 0;
 }
 
 INT32 CpsPalExit()
 {
+	BurnFree(CpsPalLookup);
 	BurnFree(CpsPal);
 	BurnFree(CpsPalSrc);
 	return 0;
 }
 
+// Make the next update convert every colour, the lookup table is only rebuilt if the colour format changed
+void CpsPalRecalc()
+{
+	if (CpsPalLookup && (nBurnBpp != nCpsPalLookupBpp || BurnHighCol != CpsPalLookupHighCol)) {
+		CpsPalLookupInit();
+	}
+	nCpsPalLastCtrl = -1;
+}
+
 // Update CpsPal with the new palette at pNewPal (length 0xc00 bytes)
+// Only the colours which differ from the previous update are converted
 INT32 CpsPalUpdate(UINT8* pNewPal)
 {
 	UINT16 *ps, *pn;
@@ -43,31 +85,34 @@ INT32 CpsPalUpdate(UINT8* pNewPal)
 	ps = (UINT16*)CpsPalSrc;
 	pn = (UINT16*)pNewPal;
 
-	memcpy(ps, pn, 0xc00 * sizeof(UINT16));
-	
 	INT32 nCtrl = CpsReg[nCpsPalCtrlReg];
-	UINT16 *PaletteRAM = (UINT16*)CpsPalSrc;
-	
+	bool bAll = (nCtrl != nCpsPalLastCtrl);
+	nCpsPalLastCtrl = nCtrl;
+
+	// Enabled pages take their data from consecutive 0x200 word blocks of the input,
+	// disabled pages only skip a block once an earlier page has been enabled
+	INT32 nSrc = 0;
+
 	for (INT32 nPage = 0; nPage < 6; nPage++) {
 		if (BIT(nCtrl, nPage)) {
+			UINT16 *pSrc = ps + nSrc;
+			UINT16 *pNew = pn + nSrc;
+			UINT32 *pDest = CpsPal + (0x200 * nPage);
+
 			for (INT32 Offset = 0; Offset < 0x200; ++Offset) {
-				INT32 Palette = BURN_ENDIAN_SWAP_INT16(*(PaletteRAM++));
-				INT32 r, g, b, Bright;
-				
-				Bright = 0x0f + ((Palette >> 12) << 1);
-
-				r = ((Palette >> 8) & 0x0f) * 0x11 * Bright / 0x2d;
-				g = ((Palette >> 4) & 0x0f) * 0x11 * Bright / 0x2d;
-				b = ((Palette >> 0) & 0x0f) * 0x11 * Bright / 0x2d;
-				
-				CpsPal[(0x200 * nPage) + (Offset ^ 15)] = BurnHighCol(r, g, b, 0);
+				if (bAll || pSrc[Offset] != pNew[Offset]) {
+					pDest[Offset ^ 15] = CpsPalLookup[BURN_ENDIAN_SWAP_INT16(pNew[Offset])];
+				}
 			}
+			nSrc += 0x200;
 		} else {
-			if (PaletteRAM != (UINT16*)CpsPalSrc) {
-				PaletteRAM += 0x200;
+			if (nSrc) {
+				nSrc += 0x200;
 			}
 		}
 	}
 
+	memcpy(ps, pn, 0xc00 * sizeof(UINT16));
+
 	return 0;
 }
@@ -145,7 +145,20 @@ for (y = 0; y < CU_SIZE; y++, pCtvLine += nBurnPitch, pCtvTile += nCtvTileAdd
  #define DO_PIX DRAWPIXEL NEXTPIXEL
 #endif
 
-#define DRAW_8 nBlank |= b; EIGHT(DO_PIX)
+// Eight transparent pixels (common around sprites) are skipped in one go
+#if CU_MASK==1
+ #define SKIP_PIX { pPix += 8 * CU_BPP; pPixZ += 8; }
+#else
+ #define SKIP_PIX { pPix += 8 * CU_BPP; }
+#endif
+
+#if CU_CARE==1
+ #define SKIP_8 { SKIP_PIX rx += 8 * 0x7fff; }
+#else
+ #define SKIP_8 SKIP_PIX
+#endif
+
+#define DRAW_8 nBlank |= b; if (b) { EIGHT(DO_PIX) } else SKIP_8
 
 #if   CU_SIZE==8
   // 8x8 tiles
@@ -179,6 +192,8 @@ for (y = 0; y < CU_SIZE; y++, pCtvLine += nBurnPitch, pCtvTile += nCtvTileAdd
 #endif
 
 #undef DRAW_8
+#undef SKIP_8
+#undef SKIP_PIX
 #undef DO_PIX
 #undef EIGHT
 #undef DRAWPIXEL
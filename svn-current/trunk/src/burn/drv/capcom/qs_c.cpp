@@ -273,6 +273,8 @@ static INT32 QscUpdate_Accum(INT32 p, INT32 c)
 
 INT32 QscUpdate(INT32 nEnd)
 {
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	INT32 nLen;
 
 	if (nEnd > nBurnSoundLen) {
@@ -53,6 +53,8 @@ static RenderSpriteFunction* RenderSprite;
 
 INT32 CaveSpriteRender(INT32 nLowPriority, INT32 nHighPriority)
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	static INT32 nMaskLeft, nMaskRight, nMaskTop, nMaskBottom;
 	CaveSprite* pBuffer;
 
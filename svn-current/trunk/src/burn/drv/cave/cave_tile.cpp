@@ -770,6 +770,8 @@ static void Cave8x8Layer(INT32 nLayer, UINT32 nPriority)
 
 INT32 CaveTileRender(INT32 nMode)
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	UINT32 nPriority;
 	INT32 nLowPriority;
 	INT32 nLayer;
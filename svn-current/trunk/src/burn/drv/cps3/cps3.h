@@ -15,7 +15,6 @@ extern UINT16 *Cps3CurPal;
 
 extern UINT32 cps3_key1, cps3_key2, cps3_isSpecial;
 extern UINT32 cps3_bios_test_hack, cps3_game_test_hack;
-extern UINT32 cps3_speedup_ram_address, cps3_speedup_code_address;
 extern UINT8 cps3_dip;
 extern UINT32 cps3_region_address, cps3_ncd_address;
 
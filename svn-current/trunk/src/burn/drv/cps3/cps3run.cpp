@@ -22,7 +22,6 @@ Port to FBA by OopsWare
 
 #define	BE_GFX		1
 //#define	FAST_BOOT	1
-#define SPEED_HACK	1		// Default should be 1, if not FPS would drop.
 
 static UINT8 *Mem = NULL, *MemEnd = NULL;
 static UINT8 *RamStart, *RamEnd;
@@ -48,14 +47,15 @@ static UINT8 *RamC000_D;
 static UINT16 *EEPROM;
 
 UINT16 *Cps3CurPal;
+static UINT16 *Cps3PalLookup;		// Cps3CurPal value for each 15-bit colour
 static UINT32 *RamScreen;
 
 UINT8 cps3_reset = 0;
-UINT8 cps3_palette_change = 0;
+UINT8 cps3_palette_change = 0;		// Set by BurnRecalcPal(), the colour format may have changed
+static UINT8 cps3_palette_reload = 0;	// Palette RAM was loaded from a savestate
 
 UINT32 cps3_key1, cps3_key2, cps3_isSpecial;
 UINT32 cps3_bios_test_hack, cps3_game_test_hack;
-UINT32 cps3_speedup_ram_address, cps3_speedup_code_address;
 UINT8 cps3_dip;
 UINT32 cps3_region_address, cps3_ncd_address;
 
@@ -498,12 +498,26 @@ static INT32 MemIndex()
 	RamEnd		= Next;
 	
 	Cps3CurPal		= (UINT16 *) Next; Next += 0x020001 * sizeof(UINT16); // iq_132 - layer disable
+	Cps3PalLookup	= (UINT16 *) Next; Next += 0x008000 * sizeof(UINT16);
 	RamScreen	= (UINT32 *) Next; Next += (512 * 2) * (224 * 2 + 32) * sizeof(UINT32);
 	
 	MemEnd		= Next;
 	return 0;
 }
 
+static void Cps3PalLookupInit()
+{
+	for (INT32 i = 0; i < 0x8000; i++) {
+		INT32 r = (i & 0x001F) << 3;	// Red
+		INT32 g = (i & 0x03E0) >> 2;	// Green
+		INT32 b = (i & 0x7C00) >> 7;	// Blue
+		r |= r >> 5;
+		g |= g >> 5;
+		b |= b >> 5;
+		Cps3PalLookup[i] = BurnHighCol(r, g, b, 0);
+	}
+}
+
 UINT8 __fastcall cps3ReadByte(UINT32 addr)
 {
 	addr &= 0xc7ffffff;
@@ -935,15 +949,7 @@ void __fastcall cps3VidWriteWord(UINT32 addr, UINT16 data)
 		RamPal[palindex ^ 1] = data;
 #endif
 
-		INT32 r = (data & 0x001F) << 3;	// Red
-		INT32 g = (data & 0x03E0) >> 2;	// Green
-		INT32 b = (data & 0x7C00) >> 7;	// Blue
-		
-		r |= r >> 5;
-		g |= g >> 5;
-		b |= b >> 5;
-			
-		Cps3CurPal[palindex] = BurnHighCol(r, g, b, 0);
+		Cps3CurPal[palindex] = Cps3PalLookup[data & 0x7fff];
 	
 	} else
 	bprintf(PRINT_NORMAL, _T("Video Attempt to write word value %4x to location %8x\n"), data, addr);
@@ -963,49 +969,6 @@ void __fastcall cps3VidWriteLong(UINT32 addr, UINT32 data)
 }
 
 
-UINT8 __fastcall cps3RamReadByte(UINT32 addr)
-{
-	if (addr == cps3_speedup_ram_address )
-		if (Sh2GetPC(0) == cps3_speedup_code_address)
-			Sh2BurnUntilInt(0);
-
-	addr &= 0x7ffff;
-#ifdef MSB_FIRST
-	return *(RamMain + addr);
-#else
-	return *(RamMain + (addr ^ 0x03));
-#endif
-}
-
-UINT16 __fastcall cps3RamReadWord(UINT32 addr)
-{
-	//bprintf(PRINT_NORMAL, _T("Ram Attempt to read long value of location %8x\n"), addr);
-	addr &= 0x7ffff;
-
-	if (addr == cps3_speedup_ram_address )
-		if (Sh2GetPC(0) == cps3_speedup_code_address) {
-			bprintf(PRINT_NORMAL, _T("Ram Attempt to read long value of location %8x\n"), addr);
-			Sh2BurnUntilInt(0);
-		}
-	
-#ifdef MSB_FIRST
-	return *(UINT16 *)(RamMain + addr);
-#else
-	return *(UINT16 *)(RamMain + (addr ^ 0x02));
-#endif
-}
-
-
-UINT32 __fastcall cps3RamReadLong(UINT32 addr)
-{
-	if (addr == cps3_speedup_ram_address )
-		if (Sh2GetPC(0) == cps3_speedup_code_address)
-			Sh2BurnUntilInt(0);
-		
-	addr &= 0x7ffff;
-	return *(UINT32 *)(RamMain + addr);
-}
-
 // CPS3 Region Patch
 static void Cps3PatchRegion()
 {
@@ -1226,15 +1189,6 @@ INT32 cps3Init()
 		Sh2SetWriteWordHandler(4, cps3VidWriteWord);
 		Sh2SetWriteLongHandler(4, cps3VidWriteLong);
 
-#ifdef SPEED_HACK
-		// install speedup read handler
-		Sh2MapHandler(5,			0x02000000 | (cps3_speedup_ram_address & 0x030000),
-							0x0200ffff | (cps3_speedup_ram_address & 0x030000), SH2_READ);
-		Sh2SetReadByteHandler (5, cps3RamReadByte);
-		Sh2SetReadWordHandler (5, cps3RamReadWord);
-		Sh2SetReadLongHandler (5, cps3RamReadLong);
-#endif
-
 	}
 	
 	BurnDrvGetVisibleSize(&cps3_gfx_width, &cps3_gfx_height);	
@@ -1244,6 +1198,7 @@ INT32 cps3Init()
 	cps3SndSetRoute(BURN_SND_CPS3SND_ROUTE_2, 1.00, BURN_SND_ROUTE_RIGHT);
 	
 	pBurnDrvPalette = (UINT32*)Cps3CurPal;
+	Cps3PalLookupInit();
 		
 	Cps3Reset();
 	return 0;
@@ -1711,6 +1666,8 @@ static INT32 WideScreenFrameDelay = 0;
 
 static void DrvDraw()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	INT32 bg_drawn[4] = { 0, 0, 0, 0 };
 
 	UINT32 fullscreenzoom = RamVReg[ 6 * 4 + 3 ] & 0xff;
@@ -1977,21 +1934,21 @@ INT32 cps3Frame()
 		Cps3Reset();
 		
 	if (cps3_palette_change) {
+		Cps3PalLookupInit();
+		cps3_palette_reload = 1;
+		cps3_palette_change = 0;
+	}
+
+	if (cps3_palette_reload) {
 		for(INT32 i=0;i<0x0020000;i++) {
 #ifdef MSB_FIRST
 			INT32 data = RamPal[i];
 #else
 			INT32 data = RamPal[i ^ 1];
 #endif
-			INT32 r = (data & 0x001F) << 3;	// Red
-			INT32 g = (data & 0x03E0) >> 2;	// Green
-			INT32 b = (data & 0x7C00) >> 7;	// Blue
-			r |= r >> 5;
-			g |= g >> 5;
-			b |= b >> 5;
-			Cps3CurPal[i] = BurnHighCol(r, g, b, 0);	
+			Cps3CurPal[i] = Cps3PalLookup[data & 0x7fff];
 		}
-		cps3_palette_change = 0;
+		cps3_palette_reload = 0;
 	}
 	
 	if (WideScreenFrameDelay == GetCurrentFrame()) {
@@ -2138,7 +2095,7 @@ INT32 cps3Scan(INT32 nAction, INT32 *pnMin)
 		if (nAction & ACB_WRITE) {
 			
 			// rebuild current palette
-			cps3_palette_change = 1;
+			cps3_palette_reload = 1;
 			
 			// remap RamCRam
 			Sh2MapMemory(((UINT8 *)RamCRam) + (cram_bank << 20), 0x04100000, 0x041fffff, SH2_RAM);
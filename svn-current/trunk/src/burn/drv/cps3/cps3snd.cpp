@@ -137,6 +137,8 @@ void cps3SndExit()
 
 void cps3SndUpdate()
 {
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	if (!pBurnSoundOut) {
 		// TODO: ???
 		// chip->key = 0;
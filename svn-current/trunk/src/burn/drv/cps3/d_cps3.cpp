@@ -1048,9 +1048,6 @@ static INT32 sfiiiInit()
 	cps3_bios_test_hack = 0x000166b4;
 	cps3_game_test_hack = 0x063cdff4;
 
-	cps3_speedup_ram_address  = 0x0200cc6c;
-	cps3_speedup_code_address = 0x06000884;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1066,9 +1063,6 @@ static INT32 sfiii2Init()
 	cps3_bios_test_hack = 0x00000000;
 	cps3_game_test_hack = 0x00000000;
 
-	cps3_speedup_ram_address  = 0x0200dfe4;
-	cps3_speedup_code_address = 0x06000884;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1084,9 +1078,6 @@ static INT32 sfiii3Init()
 	cps3_bios_test_hack = 0x00011c44;
 	cps3_game_test_hack = 0x0613ab48;
 
-	cps3_speedup_ram_address  = 0x0200d794;
-	cps3_speedup_code_address = 0x06000884;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1102,9 +1093,6 @@ static INT32 jojor1Init()
 	cps3_bios_test_hack = 0x00011c2c;
 	cps3_game_test_hack = 0x06172568;
 
-	cps3_speedup_ram_address  = 0x020223d8;
-	cps3_speedup_code_address = 0x0600065c;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1120,9 +1108,6 @@ static INT32 jojor2Init()
 	cps3_bios_test_hack = 0x00011c2c;
 	cps3_game_test_hack = 0x06172568;
 
-	cps3_speedup_ram_address  = 0x020223c0;
-	cps3_speedup_code_address = 0x0600065c;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1138,9 +1123,6 @@ static INT32 jojobaInit()
 	cps3_bios_test_hack = 0x00011c90;
 	cps3_game_test_hack = 0x061c45bc;
 
-	cps3_speedup_ram_address  = 0x020267dc;
-	cps3_speedup_code_address = 0x0600065c;
-
 	cps3_region_address = 0x0001fec8;
 	cps3_ncd_address    = 0x0001fecf;
 
@@ -1156,9 +1138,6 @@ static INT32 redearthInit()
 	cps3_bios_test_hack = 0x00016530;
 	cps3_game_test_hack = 0x060105f0;
 
-	cps3_speedup_ram_address  = 0x0202136c;
-	cps3_speedup_code_address = 0x0600194e;
-
 	cps3_region_address = 0x0001fed8;
 	cps3_ncd_address    = 0x00000000;
 
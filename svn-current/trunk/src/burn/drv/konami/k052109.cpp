@@ -221,7 +221,7 @@ void K052109RenderLayerLineScroll(INT32 nLayer, INT32 Opaque, UINT8 *pSrc)
 
 void K052109RenderLayer(INT32 nLayer, INT32 Opaque, UINT8 *pSrc)
 {
-	if (K052109EnableLine[nLayer]) {
+	if (K052109EnableLine[nLayer & 0x03]) {
 		K052109RenderLayerLineScroll(nLayer, Opaque, pSrc);
 		return;
 	}
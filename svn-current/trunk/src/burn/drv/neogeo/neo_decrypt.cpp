@@ -477,35 +477,99 @@ void NeoCMCExtractSData(UINT8* rom, UINT8* sdata, INT32 rom_size, INT32 sdata_si
 	}
 }
 
-inline static void cmc_xor(UINT8 *r0, UINT8 *r1,
-		    const UINT8 *table0hi,
-		    const UINT8 *table0lo,
-		    const UINT8 *table1,
-		    INT32 base,
-		    INT32 invert)
+struct NeoCMCDecryptJob {
+	INT32 extra_xor;
+	UINT8* rom;
+	UINT8* buf;
+	INT32 offset;
+	INT32 block_size;
+	INT32 clamp_size;
+	INT32 chunk_size;
+};
 
+static void NeoCMCDecryptChunk(INT32 nChunk, void* pParam)
 {
-	UINT8 c0, c1, tmp, xor0, xor1;
-
-	tmp = table1[(base & 0xff) ^ address_0_7_xor[(base >> 8) & 0xff]];
-	xor0 = (table0hi[(base >> 8) & 0xff] & 0xfe) | (tmp & 0x01);
-	xor1 = (tmp & 0xfe) | (table0lo[(base >> 8) & 0xff] & 0x01);
-
-    c0 = *r0;
-    c1 = *r1;
-
-	if (invert)	{
-		*r0 = c1 ^ xor0;
-		*r1 = c0 ^ xor1;
-	} else {
-		*r0 = c0 ^ xor0;
-		*r1 = c1 ^ xor1;
+	NeoCMCDecryptJob* pJob = (NeoCMCDecryptJob*)pParam;
+
+	INT32 offset = pJob->offset;
+	INT32 clamp_size = pJob->clamp_size;
+	INT32 start = nChunk * pJob->chunk_size;
+	INT32 end = (nChunk == 7) ? pJob->block_size : (start + pJob->chunk_size);
+
+	for (INT32 rpos = start; rpos < end; ) {
+
+		// The data xor values only depend on bits 0-7 within each run of 256 longwords
+		INT32 hi = (rpos >> 8) & 0xff;
+		INT32 idx_xor = address_0_7_xor[hi];
+		UINT8 t03 = type0_t03[hi];
+		UINT8 t12 = type0_t12[hi];
+		INT32 invert0 = (rpos >> 8) & 1;
+		UINT8 xor_16_23 = address_16_23_xor2[hi];
+
+		INT32 run_end = (rpos | 0xff) + 1;
+		if (run_end > end) run_end = end;
+
+		for ( ; rpos < run_end; rpos++) {
+			UINT8* src = pJob->buf + 4 * rpos;
+			UINT8 c0, c1, c2, c3, tmp;
+
+			// Data xor (bytes are handled in couples, 0&3 and 1&2)
+			INT32 idx = (rpos & 0xff) ^ idx_xor;
+
+			tmp = type1_t03[idx];
+			UINT8 xor0 = (t03 & 0xfe) | (tmp & 0x01);
+			UINT8 xor3 = (tmp & 0xfe) | (t12 & 0x01);
+
+			tmp = type1_t12[idx];
+			UINT8 xor1 = (t12 & 0xfe) | (tmp & 0x01);
+			UINT8 xor2 = (tmp & 0xfe) | (t03 & 0x01);
+
+			if (invert0) {
+				c0 = src[3] ^ xor0;
+				c3 = src[0] ^ xor3;
+			} else {
+				c0 = src[0] ^ xor0;
+				c3 = src[3] ^ xor3;
+			}
+
+			if ((((rpos + offset) >> 16) ^ xor_16_23) & 1) {
+				c1 = src[2] ^ xor1;
+				c2 = src[1] ^ xor2;
+			} else {
+				c1 = src[1] ^ xor1;
+				c2 = src[2] ^ xor2;
+			}
+
+			// Address xor
+			INT32 baser = rpos + offset;
+
+			baser ^= address_0_7_xor[(baser >> 8) & 0xff];
+			baser ^= address_16_23_xor2[(baser >> 8) & 0xff] << 16;
+			baser ^= address_16_23_xor1[baser & 0xff] << 16;
+
+			if (rpos + offset < clamp_size)
+				baser &= clamp_size - 1;
+			else
+				baser = clamp_size + (baser & ((clamp_size >> 1) - 1));
+
+			baser ^= address_8_15_xor2[baser & 0xff] << 8;
+			baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
+
+			baser ^= pJob->extra_xor;
+
+			UINT8* dst = pJob->rom + 4 * baser;
+			dst[0] = c0;
+			dst[1] = c1;
+			dst[2] = c2;
+			dst[3] = c3;
+		}
 	}
 }
 
+// Decrypts block_size bytes from buf into rom. buf is left untouched
 void NeoCMCDecrypt(INT32 extra_xor, UINT8* rom, UINT8* buf, INT32 offset, INT32 block_size, INT32 rom_size)
 {
-	INT32 clamp_size, rpos;
+	INT32 clamp_size;
 
 	if (rom_size > 0x04000000) rom_size = 0x04000000;
 
@@ -517,34 +581,9 @@ void NeoCMCDecrypt(INT32 extra_xor, UINT8* rom, UINT8* buf, INT32 offset, INT32
 	// special handling for games with 6 C ROMs
 	for (clamp_size = 1 << 30; clamp_size > rom_size; clamp_size >>= 1) { }
 
-	// Data xor
-	for (rpos = 0; rpos < block_size; rpos++)
-	{
-		cmc_xor(buf+4*rpos+0, buf+4*rpos+3, type0_t03, type0_t12, type1_t03, rpos, (rpos>>8) & 1);
-		cmc_xor(buf+4*rpos+1, buf+4*rpos+2, type0_t12, type0_t03, type1_t12, rpos, (((rpos + offset)>>16) ^ address_16_23_xor2[(rpos>>8) & 0xff]) & 1);
-	}
-
-	// Address xor
-	for (rpos = 0; rpos < block_size; rpos++)
-	{
-		INT32 baser = rpos + offset;
-
-		baser ^= address_0_7_xor[(baser >> 8) & 0xff];
-		baser ^= address_16_23_xor2[(baser >> 8) & 0xff] << 16;
-		baser ^= address_16_23_xor1[baser & 0xff] << 16;
-
-		if (rpos + offset < clamp_size)
-			baser &= clamp_size - 1;
-		else
-			baser = clamp_size + (baser & ((clamp_size >> 1) - 1));
-
-		baser ^= address_8_15_xor2[baser & 0xff] << 8;
-		baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
-
-		baser ^= extra_xor;
-
-		((UINT32*)rom)[baser] = ((UINT32*)buf)[rpos];
-	}
+	// Every longword goes to a different address, so the block can be split up
+	NeoCMCDecryptJob Job = { extra_xor, rom, buf, offset, block_size, clamp_size, block_size >> 3 };
+	BurnParallel(8, NeoCMCDecryptChunk, &Job);
 }
 
 /* CMC42 protection chip */
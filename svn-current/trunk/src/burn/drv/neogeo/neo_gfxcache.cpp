@@ -0,0 +1,212 @@
+// Neo Geo -- on-disk cache of the decrypted and decoded sprite/text graphics
+
+#include "neogeo.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define NEO_GFXCACHE_VERSION	(2)
+#define NEO_GFXCACHE_ALIGN		(0x1000)		// Sprite data starts on a page boundary, so it can be mapped
+
+struct NeoGfxCacheHeader {
+	char szMagic[8];
+	UINT32 nVersion;
+	char szName[32];
+	UINT32 nRomKey;								// Hash of the CRCs and sizes of the ROM files loaded
+	UINT32 nSpriteSize;
+	UINT32 nTextSize;
+};
+
+static const char szNeoGfxCacheMagic[8] = { 'F', 'B', 'A', 'N', 'G', 'F', 'X', 0 };
+
+// Sprite ROMs which are mapped from a cache file rather than allocated
+static UINT8* NeoGfxCacheMap[MAX_SLOT] = { NULL, };
+static UINT32 nNeoGfxCacheMapSize[MAX_SLOT] = { 0, };
+
+static INT32 NeoGfxCacheFilename(TCHAR* szFilename)
+{
+	if (szAppGfxCachePath[0] == 0) {
+		return 1;
+	}
+
+	_stprintf(szFilename, _T("%s%s.neogfx"), szAppGfxCachePath, BurnDrvGetText(DRV_NAME));
+
+	return 0;
+}
+
+// The files actually loaded are used rather than the driver's rom info, since a
+// ROM with the right name but the wrong CRC is loaded too
+static INT32 NeoGfxCacheRomKey(UINT32* pnKey)
+{
+	struct BurnRomInfo ri;
+	UINT32 nKey = 2166136261U;
+
+	if (BurnExtRomFileInfo == NULL) {
+		return 1;
+	}
+
+	for (INT32 i = 0; !BurnDrvGetRomInfo(&ri, i); i++) {
+		UINT32 nCrc, nLen;
+
+		if (ri.nType == 0 || BurnExtRomFileInfo(i, &nCrc, &nLen)) {
+			continue;
+		}
+		nKey = (nKey ^ i) * 16777619U;
+		nKey = (nKey ^ nCrc) * 16777619U;
+		nKey = (nKey ^ nLen) * 16777619U;
+	}
+
+	*pnKey = nKey;
+
+	return 0;
+}
+
+static INT32 NeoGfxCacheMakeHeader(NeoGfxCacheHeader* pHeader, UINT32 nSpriteSize, UINT32 nTextSize)
+{
+	memset(pHeader, 0, sizeof(NeoGfxCacheHeader));
+
+	if (NeoGfxCacheRomKey(&pHeader->nRomKey)) {
+		return 1;
+	}
+
+	memcpy(pHeader->szMagic, szNeoGfxCacheMagic, sizeof(pHeader->szMagic));
+	pHeader->nVersion = NEO_GFXCACHE_VERSION;
+	strncpy(pHeader->szName, BurnDrvGetTextA(DRV_NAME), sizeof(pHeader->szName) - 1);
+	pHeader->nSpriteSize = nSpriteSize;
+	pHeader->nTextSize = nTextSize;
+
+	return 0;
+}
+
+// Order-sensitive hash of the graphics, used to check if a driver callback modifies them
+UINT32 NeoGfxCacheChecksum(UINT8* pSprite, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize)
+{
+	UINT32 nSum = 2166136261U;
+
+	for (UINT32 i = 0; i < (nSpriteSize >> 2); i++) {
+		nSum = (nSum ^ ((UINT32*)pSprite)[i]) * 16777619U;
+	}
+	for (UINT32 i = 0; i < nTextSize; i++) {
+		nSum = (nSum ^ pText[i]) * 16777619U;
+	}
+
+	return nSum;
+}
+
+// Try to get the sprite and text data from the cache. On success, the returned
+// sprite ROM must be released with NeoGfxCacheFree(); NULL means a cache miss.
+UINT8* NeoGfxCacheLoad(INT32 nSlot, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize)
+{
+	TCHAR szFilename[MAX_PATH];
+	NeoGfxCacheHeader Header, Expected;
+
+	if (NeoGfxCacheFilename(szFilename) || NeoGfxCacheMakeHeader(&Expected, nSpriteSize, nTextSize)) {
+		return NULL;
+	}
+
+	FILE* fp = _tfopen(szFilename, _T("rb"));
+	if (fp == NULL) {
+		return NULL;
+	}
+
+	if (fread(&Header, sizeof(Header), 1, fp) != 1 || memcmp(&Header, &Expected, sizeof(Header))) {
+		fclose(fp);
+		return NULL;
+	}
+
+	UINT8* pSprite = NULL;
+
+	fseek(fp, NEO_GFXCACHE_ALIGN, SEEK_SET);
+	if (fread(pText, 1, nTextSize, fp) != nTextSize) {
+		fclose(fp);
+		return NULL;
+	}
+
+	UINT32 nSpriteOffset = (NEO_GFXCACHE_ALIGN + nTextSize + NEO_GFXCACHE_ALIGN - 1) & ~(NEO_GFXCACHE_ALIGN - 1);
+
+#ifdef HAVE_MMAP
+	// Private mapping: clean pages come straight from the page cache and are shared
+	// with any other instance running the same game
+	void* pMap = mmap(NULL, nSpriteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(fp), nSpriteOffset);
+	if (pMap != MAP_FAILED) {
+		struct stat st;
+		if (fstat(fileno(fp), &st) == 0 && (UINT64)st.st_size >= (UINT64)nSpriteOffset + nSpriteSize) {
+			pSprite = (UINT8*)pMap;
+			NeoGfxCacheMap[nSlot] = pSprite;
+			nNeoGfxCacheMapSize[nSlot] = nSpriteSize;
+		} else {
+			munmap(pMap, nSpriteSize);
+		}
+	}
+#endif
+
+	if (pSprite == NULL) {
+		pSprite = (UINT8*)BurnMalloc(nSpriteSize);
+		if (pSprite) {
+			fseek(fp, nSpriteOffset, SEEK_SET);
+			if (fread(pSprite, 1, nSpriteSize, fp) != nSpriteSize) {
+				BurnFree(pSprite);
+			}
+		}
+	}
+
+	fclose(fp);
+
+	return pSprite;
+}
+
+INT32 NeoGfxCacheSave(UINT8* pSprite, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize)
+{
+	TCHAR szFilename[MAX_PATH];
+	TCHAR szTempname[MAX_PATH + 4];
+	NeoGfxCacheHeader Header;
+
+	if (NeoGfxCacheFilename(szFilename) || NeoGfxCacheMakeHeader(&Header, nSpriteSize, nTextSize)) {
+		return 1;
+	}
+
+	// Another instance may have the old file mapped, so it's replaced rather than rewritten
+	_stprintf(szTempname, _T("%s.tmp"), szFilename);
+
+	FILE* fp = _tfopen(szTempname, _T("wb"));
+	if (fp == NULL) {
+		return 1;
+	}
+
+	UINT32 nSpriteOffset = (NEO_GFXCACHE_ALIGN + nTextSize + NEO_GFXCACHE_ALIGN - 1) & ~(NEO_GFXCACHE_ALIGN - 1);
+
+	bool bOkay = fwrite(&Header, sizeof(Header), 1, fp) == 1;
+	bOkay = bOkay && fseek(fp, NEO_GFXCACHE_ALIGN, SEEK_SET) == 0;
+	bOkay = bOkay && fwrite(pText, 1, nTextSize, fp) == nTextSize;
+	bOkay = bOkay && fseek(fp, nSpriteOffset, SEEK_SET) == 0;
+	bOkay = bOkay && fwrite(pSprite, 1, nSpriteSize, fp) == nSpriteSize;
+
+	bOkay = (fclose(fp) == 0) && bOkay;
+
+	if (!bOkay || rename(szTempname, szFilename)) {
+		// Don't leave a truncated file behind
+		remove(szTempname);
+		return 1;
+	}
+
+	return 0;
+}
+
+void NeoGfxCacheFree(INT32 nSlot, UINT8** ppSprite)
+{
+#ifdef HAVE_MMAP
+	if (*ppSprite && *ppSprite == NeoGfxCacheMap[nSlot]) {
+		munmap(NeoGfxCacheMap[nSlot], nNeoGfxCacheMapSize[nSlot]);
+		NeoGfxCacheMap[nSlot] = NULL;
+		nNeoGfxCacheMapSize[nSlot] = 0;
+		*ppSprite = NULL;
+		return;
+	}
+#endif
+
+	BurnFree(*ppSprite);
+}
@@ -644,11 +644,24 @@ static INT32 LoadRoms()
 //		nSpriteSize[nNeoActiveSlot] = 0x5000000;
 //	}
 
-	NeoSpriteROM[nNeoActiveSlot] = (UINT8*)BurnMalloc(nSpriteSize[nNeoActiveSlot] < (nNeoTileMask[nNeoActiveSlot] << 7) ? ((nNeoTileMask[nNeoActiveSlot] + 1) << 7) : nSpriteSize[nNeoActiveSlot]);
-	if (NeoSpriteROM[nNeoActiveSlot] == NULL) {
+	UINT32 nSpriteAlloc = nSpriteSize[nNeoActiveSlot] < (nNeoTileMask[nNeoActiveSlot] << 7) ? ((nNeoTileMask[nNeoActiveSlot] + 1) << 7) : nSpriteSize[nNeoActiveSlot];
+
+	NeoTextROM[nNeoActiveSlot] = (UINT8*)BurnMalloc(nNeoTextROMSize[nNeoActiveSlot]);
+	if (NeoTextROM[nNeoActiveSlot] == NULL) {
 		return 1;
 	}
 
+	// Decrypted and decoded graphics from a previous run
+	NeoSpriteROM[nNeoActiveSlot] = NeoGfxCacheLoad(nNeoActiveSlot, nSpriteAlloc, NeoTextROM[nNeoActiveSlot], nNeoTextROMSize[nNeoActiveSlot]);
+	bool bGfxCached = NeoSpriteROM[nNeoActiveSlot] != NULL;
+
+	if (!bGfxCached) {
+		NeoSpriteROM[nNeoActiveSlot] = (UINT8*)BurnMalloc(nSpriteAlloc);
+		if (NeoSpriteROM[nNeoActiveSlot] == NULL) {
+			return 1;
+		}
+	}
+
 /*	if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SNK_DEDICATED_PCB) {
 		BurnSetProgressRange(1.0 / ((double)nSpriteSize[nNeoActiveSlot] / 0x800000 / 12));
 	} else if (BurnDrvGetHardwareCode() & (HARDWARE_SNK_CMC42 | HARDWARE_SNK_CMC50)) {
@@ -667,16 +680,11 @@ static INT32 LoadRoms()
 		BurnSetProgressRange(1.0 / pInfo->nSpriteNum);
 	}
 
-	// Load sprite data
-	NeoLoadSprites(pInfo->nSpriteOffset, pInfo->nSpriteNum, NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
-
-	NeoTextROM[nNeoActiveSlot] = (UINT8*)BurnMalloc(nNeoTextROMSize[nNeoActiveSlot]);
-	if (NeoTextROM[nNeoActiveSlot] == NULL) {
-		return 1;
-	}
+	if (!bGfxCached) {
+		// Load sprite data
+		NeoLoadSprites(pInfo->nSpriteOffset, pInfo->nSpriteNum, NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
 
-	// Load Text layer tiledata
-	{
+		// Load Text layer tiledata
 		if (pInfo->nTextOffset != -1) {
 			// Load S ROM data
 			BurnLoadRom(NeoTextROM[nNeoActiveSlot], pInfo->nTextOffset, 1);
@@ -684,7 +692,7 @@ static INT32 LoadRoms()
 			// Extract data from the end of C ROMS
 			BurnUpdateProgress(0.0, _T("Decrypting text layer graphics...")/*, BST_DECRYPT_TXT*/, 0);
 			NeoCMCExtractSData(NeoSpriteROM[nNeoActiveSlot], NeoTextROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot], nNeoTextROMSize[nNeoActiveSlot]);
-			
+		
 			if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SNK_DEDICATED_PCB) {
 				for (INT32 i = 0; i < nNeoTextROMSize[nNeoActiveSlot]; i++) {
 					NeoTextROM[nNeoActiveSlot][i] = BITSWAP08(NeoTextROM[nNeoActiveSlot][i] ^ 0xd2, 4, 0, 7, 2, 5, 1, 6, 3);
@@ -719,16 +727,34 @@ static INT32 LoadRoms()
 		neogeo_cmc50_m1_decrypt();
 	}
 	
+	// Only cache the graphics if the driver callback leaves them alone, since it runs again on every start
+	bool bGfxCacheable = !bGfxCached && szAppGfxCachePath[0];
+	UINT32 nGfxChecksum = 0;
+
+	if (bGfxCacheable && NeoCallbackActive && NeoCallbackActive->pInitialise) {
+		nGfxChecksum = NeoGfxCacheChecksum(NeoSpriteROM[nNeoActiveSlot], nSpriteAlloc, NeoTextROM[nNeoActiveSlot], nNeoTextROMSize[nNeoActiveSlot]);
+	}
+
 	if (NeoCallbackActive && NeoCallbackActive->pInitialise) {
 		NeoCallbackActive->pInitialise();
+
+		if (bGfxCacheable && nGfxChecksum != NeoGfxCacheChecksum(NeoSpriteROM[nNeoActiveSlot], nSpriteAlloc, NeoTextROM[nNeoActiveSlot], nNeoTextROMSize[nNeoActiveSlot])) {
+			bGfxCacheable = false;
+		}
 	}
 
-	// Decode text data
-	BurnUpdateProgress(0.0, _T("Preprocessing text layer graphics...")/*, BST_PROCESS_TXT*/, 0);
-	NeoDecodeText(0, nNeoTextROMSize[nNeoActiveSlot], NeoTextROM[nNeoActiveSlot], NeoTextROM[nNeoActiveSlot]);
+	if (!bGfxCached) {
+		// Decode text data
+		BurnUpdateProgress(0.0, _T("Preprocessing text layer graphics...")/*, BST_PROCESS_TXT*/, 0);
+		NeoDecodeText(0, nNeoTextROMSize[nNeoActiveSlot], NeoTextROM[nNeoActiveSlot], NeoTextROM[nNeoActiveSlot]);
+
+		// Decode sprite data
+		NeoDecodeSprites(NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
 
-	// Decode sprite data
-	NeoDecodeSprites(NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
+		if (bGfxCacheable) {
+			NeoGfxCacheSave(NeoSpriteROM[nNeoActiveSlot], nSpriteAlloc, NeoTextROM[nNeoActiveSlot], nNeoTextROMSize[nNeoActiveSlot]);
+		}
+	}
 
 	if (pInfo->nADPCMANum) {
 		char* pName;
@@ -4211,7 +4237,7 @@ INT32 NeoExit()
 			BurnFree(NeoTextROM[nNeoActiveSlot]);						// Text ROM
 			nNeoTextROMSize[nNeoActiveSlot] = 0;
 
-			BurnFree(NeoSpriteROM[nNeoActiveSlot]);						// Sprite ROM
+			NeoGfxCacheFree(nNeoActiveSlot, &NeoSpriteROM[nNeoActiveSlot]);	// Sprite ROM
 			BurnFree(Neo68KROM[nNeoActiveSlot]);						// 68K ROM
 			BurnFree(NeoVector[nNeoActiveSlot]);						// 68K vectors
 			BurnFree(NeoZ80ROM[nNeoActiveSlot]);						// Z80 ROM
@@ -4267,6 +4293,8 @@ INT32 NeoExit()
 
 INT32 NeoRender()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	NeoUpdatePalette();							// Update the palette
 	NeoClearScreen();
 
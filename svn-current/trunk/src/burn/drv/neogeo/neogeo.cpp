@@ -228,6 +228,60 @@ INT32 NeoLoadSprites(INT32 nOffset, INT32 nNum, UINT8* pDest, UINT32 nSpriteSize
 // ----------------------------------------------------------------------------
 // Graphics decoding for MVS/AES
 
+// Spreads the 8 bits of a bitplane byte out to bit 0 of each nibble of a longword
+static UINT32 NeoSpriteSpread[256];
+
+static void NeoSpriteSpreadInit()
+{
+	if (NeoSpriteSpread[0x80]) {
+		return;
+	}
+
+	for (INT32 i = 0; i < 256; i++) {
+		UINT32 n = 0;
+		for (INT32 x = 0; x < 8; x++) {
+			n |= ((i >> x) & 1) << (x << 2);
+		}
+		NeoSpriteSpread[i] = n;
+	}
+}
+
+// Convert one 128-byte tile from 4 bitplanes to packed nibbles. p0-p3 are the
+// offsets of the bytes holding bitplanes 0-3 in each group of 4 bytes
+static inline void NeoDecodeTile(UINT8* pTile, UINT8* pDest, INT32 p0, INT32 p1, INT32 p2, INT32 p3)
+{
+	UINT32 data[32];
+
+	for (INT32 y = 0; y < 16; y++) {
+		UINT8* pRow = pTile + (y << 2);
+
+		data[(y << 1) + 0] = NeoSpriteSpread[pRow[64 + p0]] | (NeoSpriteSpread[pRow[64 + p1]] << 1) | (NeoSpriteSpread[pRow[64 + p2]] << 2) | (NeoSpriteSpread[pRow[64 + p3]] << 3);
+		data[(y << 1) + 1] = NeoSpriteSpread[pRow[ 0 + p0]] | (NeoSpriteSpread[pRow[ 0 + p1]] << 1) | (NeoSpriteSpread[pRow[ 0 + p2]] << 2) | (NeoSpriteSpread[pRow[ 0 + p3]] << 3);
+	}
+
+	for (INT32 n = 0; n < 32; n++) {
+		((UINT32*)pDest)[n] = data[n];
+	}
+}
+
+struct NeoDecodeSpritesJob {
+	UINT8* pDest;
+	INT32 nChunkSize;
+};
+
+static void NeoDecodeSpritesChunk(INT32 nChunk, void* pParam)
+{
+	NeoDecodeSpritesJob* pJob = (NeoDecodeSpritesJob*)pParam;
+
+	UINT8* pStart = pJob->pDest + nChunk * pJob->nChunkSize;
+	UINT8* pEnd = pStart + pJob->nChunkSize;
+
+	// Pre-process the sprite graphics
+	for (UINT8* pTile = pStart; pTile < pEnd; pTile += 128) {
+		NeoDecodeTile(pTile, pTile, 0, 2, 1, 3);
+	}
+}
+
 void NeoDecodeSprites(UINT8* pDest, INT32 nSize)
 {
 //	double dProgress = 0.0;
@@ -244,51 +298,17 @@ void NeoDecodeSprites(UINT8* pDest, INT32 nSize)
 		dProgress = 1.0 /  8.0;
 	}*/
 
-	for (INT32 i = 0; i < 8; i++) {
-
-		UINT8* pStart = pDest + i * (nSize >> 3);
-		UINT8* pEnd = pStart + (nSize >> 3);
-
-//		BurnUpdateProgress(dProgress, i ? NULL : _T("Preprocessing graphics...")/*, BST_PROCESS_GRA*/, 0);
-
-		INT32 nStep = 8;
-		if (BurnDrvGetHardwareCode() & (HARDWARE_SNK_CMC42 | HARDWARE_SNK_CMC50)) {
-			nStep *= 4;
-		}
-		BurnUpdateProgress(1.0 / nStep, i ? NULL : _T("Preprocessing graphics..."), 0);
-
-		// Pre-process the sprite graphics
-		for (UINT8* pTile = pStart; pTile < pEnd; pTile += 128) {
-			UINT32 data[32];
-
-			for (INT32 y = 0; y < 16; y++) {
-				UINT32 n = 0;
-				for (INT32 x = 0; x < 8; x++) {
-					UINT32 m = ((pTile[67 + (y << 2)] >> x) & 1) << 3;
-					m |= ((pTile[65 + (y << 2)] >> x) & 1) << 2;
-					m |= ((pTile[66 + (y << 2)] >> x) & 1) << 1;
-					m |= ((pTile[64 + (y << 2)] >> x) & 1) << 0;
-
-					n |= m << (x << 2);
-				}
-				data[(y << 1) + 0] = n;
+	INT32 nStep = 8;
+	if (BurnDrvGetHardwareCode() & (HARDWARE_SNK_CMC42 | HARDWARE_SNK_CMC50)) {
+		nStep *= 4;
+	}
+	BurnUpdateProgress(8.0 / nStep, _T("Preprocessing graphics..."), 0);
 
-				n = 0;
-				for (INT32 x = 0; x < 8; x++) {
-					UINT32 m = ((pTile[3 + (y << 2)] >> x) & 1) << 3;
-					m |= ((pTile[1 + (y << 2)] >> x) & 1) << 2;
-					m |= ((pTile[2 + (y << 2)] >> x) & 1) << 1;
-					m |= ((pTile[0 + (y << 2)] >> x) & 1) << 0;
+	NeoSpriteSpreadInit();
 
-					n |= m << (x << 2);
-				}
-				data[(y << 1) + 1] = n;
-			}
-			for (INT32 n = 0; n < 32; n++) {
-				((UINT32*)pTile)[n] = data[n];
-			}
-		}
-	}
+	// The data is processed in 8 chunks, which can be done in parallel
+	NeoDecodeSpritesJob Job = { pDest, nSize >> 3 };
+	BurnParallel(8, NeoDecodeSpritesChunk, &Job);
 }
 
 /*
@@ -319,37 +339,10 @@ void NeoDecodeSpritesCD(UINT8* pData, UINT8* pDest, INT32 nSize)
 {
 	UINT8* pEnd = pData + nSize;
 
-	for (UINT8* pTile = pData; pTile < pEnd; pTile += 128, pDest += 128) {
-		UINT32 data[32];
-
-		for (INT32 y = 0; y < 16; y++) {
-			UINT32 n = 0;
-
-			for (INT32 x = 0; x < 8; x++) {
-				UINT32 m = ((pTile[67 + (y << 2)] >> x) & 1) << 3;
-				m |= ((pTile[66 + (y << 2)] >> x) & 1) << 2;
-				m |= ((pTile[65 + (y << 2)] >> x) & 1) << 1;
-				m |= ((pTile[64 + (y << 2)] >> x) & 1) << 0;
-
-				n |= m << (x << 2);
-			}
-			data[(y << 1) + 0] = n;
-
-			n = 0;
-			for (INT32 x = 0; x < 8; x++) {
-				UINT32 m = ((pTile[3 + (y << 2)] >> x) & 1) << 3;
-				m |= ((pTile[2 + (y << 2)] >> x) & 1) << 2;
-				m |= ((pTile[1 + (y << 2)] >> x) & 1) << 1;
-				m |= ((pTile[0 + (y << 2)] >> x) & 1) << 0;
+	NeoSpriteSpreadInit();
 
-				n |= m << (x << 2);
-			}
-			data[(y << 1) + 1] = n;
-		}
-
-		for (INT32 n = 0; n < 32; n++) {
-			((UINT32*)pDest)[n] = data[n];
-		}
+	for (UINT8* pTile = pData; pTile < pEnd; pTile += 128, pDest += 128) {
+		NeoDecodeTile(pTile, pDest, 0, 1, 2, 3);
 	}
 }
 
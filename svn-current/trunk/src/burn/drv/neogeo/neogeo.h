@@ -48,6 +48,12 @@ INT32 NeoLoadADPCM(INT32 nOffset, INT32 nNum, UINT8* pDest);
 void NeoDecodeSprites(UINT8* pDest, INT32 nSize);
 void NeoDecodeSpritesCD(UINT8* pData, UINT8* pDest, INT32 nSize);
 
+// neo_gfxcache.cpp
+UINT32 NeoGfxCacheChecksum(UINT8* pSprite, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize);
+UINT8* NeoGfxCacheLoad(INT32 nSlot, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize);
+INT32 NeoGfxCacheSave(UINT8* pSprite, UINT32 nSpriteSize, UINT8* pText, UINT32 nTextSize);
+void NeoGfxCacheFree(INT32 nSlot, UINT8** ppSprite);
+
 // neo_run.cpp
 extern UINT8* NeoGraphicsRAM;
 
@@ -620,6 +620,8 @@ static void draw_background()
 
 INT32 pgmDraw()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (nPgmPalRecalc) {
 		for (INT32 i = 0; i < 0x1200 / 2; i++) {
 			RamCurPal[i] = CalcCol(PGMPalRAM[i]);
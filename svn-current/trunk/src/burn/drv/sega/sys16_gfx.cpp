@@ -1,4 +1,5 @@
 #include "sys16.h"
+#include "tiles_cache.h"
 
 INT32 System16SpriteBanks[16];
 INT32 System16TileBanks[8];
@@ -184,6 +185,13 @@ static void RenderTile_Mask(UINT16* pDestDraw, INT32 nTileNumber, INT32 StartX,
 #undef PLOTPIXEL
 #undef PLOTPIXEL_MASK
 
+// The tilemaps are kept pre-rendered, what every tile was drawn with is kept in a
+// tile cache so only the tiles that changed are redrawn
+#define SYS16_CACHE_BG			0
+#define SYS16_CACHE_BGALT		1
+#define SYS16_CACHE_FG			2
+#define SYS16_CACHE_FGALT		3
+
 void System16ATileMapsInit(INT32 bOpaque)
 {
 	if (bOpaque) {
@@ -194,6 +202,9 @@ void System16ATileMapsInit(INT32 bOpaque)
 	pSys16BgTileMapPri1 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
 	pSys16FgTileMapPri0 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
 	pSys16FgTileMapPri1 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
+
+	TileCacheInit(SYS16_CACHE_BG, 128 * 64);
+	TileCacheInit(SYS16_CACHE_FG, 128 * 64);
 }
 
 void System16BTileMapsInit(INT32 bOpaque)
@@ -212,6 +223,11 @@ void System16BTileMapsInit(INT32 bOpaque)
 	pSys16BgAltTileMapPri1 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
 	pSys16FgAltTileMapPri0 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
 	pSys16FgAltTileMapPri1 = (UINT16*)BurnMalloc(1024 * 512 * sizeof(UINT16));
+
+	TileCacheInit(SYS16_CACHE_BG, 128 * 64);
+	TileCacheInit(SYS16_CACHE_BGALT, 128 * 64);
+	TileCacheInit(SYS16_CACHE_FG, 128 * 64);
+	TileCacheInit(SYS16_CACHE_FGALT, 128 * 64);
 }
 
 void System16TileMapsExit()
@@ -226,509 +242,93 @@ void System16TileMapsExit()
 	BurnFree(pSys16BgAltTileMapPri1);
 	BurnFree(pSys16FgAltTileMapPri0);
 	BurnFree(pSys16FgAltTileMapPri1);
+
+	TileCacheExit();
 }
 
-static void System16ACreateBgTileMaps()
+#define SYS16_TILES_A			0
+#define SYS16_TILES_B			1
+#define SYS16_TILES_BALT		2
+
+static void System16ClearTile(UINT16 *pDestDraw, INT32 StartX, INT32 StartY)
 {
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, i, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	UINT16 *pDest = NULL;
-	
-	if (System16CreateOpaqueTileMaps) memset(pSys16BgTileMapOpaque, 0, 1024 * 512 * sizeof(UINT16));
-	EffPage = System16Page[1];
-	EffPage = ((EffPage >> 4) & 0x0707) | ((EffPage << 4) & 0x7070);
-	if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SEGA_HANGON) EffPage &= 0x3333;
-	for (i = 0; i < 2; i++) {
-		if (i == 0) pDest = pSys16BgTileMapPri0;
-		if (i == 1) pDest = pSys16BgTileMapPri1;
-		memset(pDest, 0, 1024 * 512 * sizeof(UINT16));
-		for (TilePage = 0; TilePage < 4; TilePage++) {
-			ActPage = (EffPage >> 0) & 0x0f;
-			xOffs = 0;
-			yOffs = 0;
-			if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-			if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-			if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-			for (my = 0; my < 32; my++) {
-				y = 8 * my;
-				y += yOffs;
-				for (mx = 0; mx < 64; mx++) {
-					TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-						
-					Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-					Priority = (Attr >> 12) & 1;
-			
-					if (Priority != i) continue;
-					
-					x = 8 * mx;
-					x += xOffs;
-								
-					Code = ((Attr >> 1) & 0x1000) | (Attr & 0xfff);
-					Code &= (System16NumTiles - 1);
-					Colour = (Attr >> 5) & 0x7f;
-				
-					ColourOff = System16TilemapColorOffset;
-					if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-					if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-					if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-			
-					if (System16CreateOpaqueTileMaps) RenderTile(pSys16BgTileMapOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
-					RenderTile_Mask(pDest, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				}
-			}
-		}
+	UINT16* pPixel = pDestDraw + (StartY * 1024) + StartX;
+
+	for (INT32 y = 0; y < 8; y++, pPixel += 1024) {
+		memset(pPixel, 0, 8 * sizeof(UINT16));
 	}
 }
 
-static void System16ACreateFgTileMaps()
+static void System16CreateTileMap(INT32 nCache, INT32 nType, UINT16 EffPage, UINT16 *pPri0, UINT16 *pPri1, UINT16 *pOpaque)
 {
 	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, xOffs, yOffs;
 	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	
-	memset(pSys16FgTileMapPri0, 0, 1024 * 512 * sizeof(UINT16));
-	memset(pSys16FgTileMapPri1, 0, 1024 * 512 * sizeof(UINT16));
-		
-	EffPage = System16Page[0];
-	EffPage = ((EffPage >> 4) & 0x0707) | ((EffPage << 4) & 0x7070);
-	if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SEGA_HANGON) EffPage &= 0x3333;
+	UINT16 ActPage;
+
 	for (TilePage = 0; TilePage < 4; TilePage++) {
-		ActPage = (EffPage >> 0) & 0x0f;
-		xOffs = 0;
-		yOffs = 0;
-		if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-		if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-		if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
+		ActPage = (EffPage >> (TilePage * 4)) & 0x0f;
+		xOffs = (TilePage & 1) ? 512 : 0;
+		yOffs = (TilePage & 2) ? 256 : 0;
 		for (my = 0; my < 32; my++) {
 			y = 8 * my;
 			y += yOffs;
 			for (mx = 0; mx < 64; mx++) {
 				TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-					
-				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-				Priority = (Attr >> 12) & 1;
-			
-				x = 8 * mx;
-				x += xOffs;
-			
-				Code = ((Attr >> 1) & 0x1000) | (Attr & 0xfff);
-				Code &= (System16NumTiles - 1);
-				Colour = (Attr >> 5) & 0x7f;
-				
-				ColourOff = System16TilemapColorOffset;
-				if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-				if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-				if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-		
-				if (Priority == 0) RenderTile_Mask(pSys16FgTileMapPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				if (Priority == 1) RenderTile_Mask(pSys16FgTileMapPri1, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-			}
-		}
-	}
-}
 
-static void System16BCreateBgTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, i, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	UINT16 *pDest = NULL;
-		
-	if (System16CreateOpaqueTileMaps) memset(pSys16BgTileMapOpaque, 0, 1024 * 512 * sizeof(UINT16));
-	EffPage = System16Page[1];
-	for (i = 0; i < 2; i++) {
-		if (i == 0) pDest = pSys16BgTileMapPri0;
-		if (i == 1) pDest = pSys16BgTileMapPri1;
-		memset(pDest, 0, 1024 * 512 * sizeof(UINT16));
-		for (TilePage = 0; TilePage < 4; TilePage++) {
-			ActPage = (EffPage >> 0) & 0x0f;
-			xOffs = 0;
-			yOffs = 0;
-			if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-			if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-			if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-			for (my = 0; my < 32; my++) {
-				y = 8 * my;
-				y += yOffs;
-				for (mx = 0; mx < 64; mx++) {
-					TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-						
-					Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-					Priority = (Attr >> 15) & 1;
-			
-					if (Priority != i) continue;
-					
-					x = 8 * mx;
-					x += xOffs;
-								
-					Code = Attr & 0x1fff;
-					Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-					Code &= (System16NumTiles - 1);
-					Colour = (Attr >> 6) & 0x7f;
-				
-					ColourOff = System16TilemapColorOffset;
-					if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-					if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-					if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-			
-					if (System16CreateOpaqueTileMaps) RenderTile(pSys16BgTileMapOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
-					RenderTile_Mask(pDest, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				}
-			}
-		}
-	}
-}
+				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
 
-static void System16BCreateBgAltTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, i, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	UINT16 *pDest = NULL;
-	
-	if (System16CreateOpaqueTileMaps) memset(pSys16BgAltTileMapOpaque, 0, 1024 * 512 * sizeof(UINT16));
-	EffPage = System16Page[3];
-	for (i = 0; i < 2; i++) {
-		if (i == 0) pDest = pSys16BgAltTileMapPri0;
-		if (i == 1) pDest = pSys16BgAltTileMapPri1;
-		if (System16RecalcBgAltTileMap) memset(pDest, 0,1024 * 512 * sizeof(UINT16));
-		for (TilePage = 0; TilePage < 4; TilePage++) {
-			ActPage = (EffPage >> 0) & 0x0f;
-			xOffs = 0;
-			yOffs = 0;
-			if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-			if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-			if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-			for (my = 0; my < 32; my++) {
-				y = 8 * my;
-				y += yOffs;
-				for (mx = 0; mx < 64; mx++) {
-					TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-						
-					Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
+				if (nType == SYS16_TILES_A) {
+					Priority = (Attr >> 12) & 1;
+					Code = ((Attr >> 1) & 0x1000) | (Attr & 0xfff);
+					Colour = (Attr >> 5) & 0x7f;
+				} else {
 					Priority = (Attr >> 15) & 1;
-			
-					if (Priority != i) continue;
-					
-					x = 8 * mx;
-					x += xOffs;
-			
 					Code = Attr & 0x1fff;
 					Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-					Code &= (System16NumTiles - 1);
-					Colour = (Attr >> 6) & 0x7f;
-				
-					ColourOff = System16TilemapColorOffset;
-					if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-					if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-					if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-			
-					if (System16CreateOpaqueTileMaps) RenderTile(pSys16BgAltTileMapOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
-					if (System16RecalcBgAltTileMap) RenderTile_Mask(pDest, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
+					Colour = (Attr >> ((nType == SYS16_TILES_B) ? 6 : 5)) & 0x7f;
 				}
-			}
-		}
-	}
-}
 
-static void System16BCreateFgTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	
-	memset(pSys16FgTileMapPri0, 0, 1024 * 512 * sizeof(UINT16));
-	memset(pSys16FgTileMapPri1, 0, 1024 * 512 * sizeof(UINT16));
-		
-	EffPage = System16Page[0];
-	for (TilePage = 0; TilePage < 4; TilePage++) {
-		ActPage = (EffPage >> 0) & 0x0f;
-		xOffs = 0;
-		yOffs = 0;
-		if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-		if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-		if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-		for (my = 0; my < 32; my++) {
-			y = 8 * my;
-			y += yOffs;
-			for (mx = 0; mx < 64; mx++) {
-				TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-					
-				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-				Priority = (Attr >> 15) & 1;
-			
-				x = 8 * mx;
-				x += xOffs;
-			
-				Code = Attr & 0x1fff;
-				Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
 				Code &= (System16NumTiles - 1);
-				Colour = (Attr >> 6) & 0x7f;
-			
+
 				ColourOff = System16TilemapColorOffset;
 				if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
 				if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
 				if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-		
-				if (Priority == 0) RenderTile_Mask(pSys16FgTileMapPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				if (Priority == 1) RenderTile_Mask(pSys16FgTileMapPri1, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-			}
-		}
-	}
-}
 
-static void System16BCreateFgAltTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	
-	memset(pSys16FgAltTileMapPri0, 0, 1024 * 512 * sizeof(UINT16));
-	memset(pSys16FgAltTileMapPri1, 0, 1024 * 512 * sizeof(UINT16));
-		
-	EffPage = System16Page[2];
-	for (TilePage = 0; TilePage < 4; TilePage++) {
-		ActPage = (EffPage >> 0) & 0x0f;
-		xOffs = 0;
-		yOffs = 0;
-		if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-		if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-		if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-		for (my = 0; my < 32; my++) {
-			y = 8 * my;
-			y += yOffs;
-			for (mx = 0; mx < 64; mx++) {
-				TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-					
-				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-				Priority = (Attr >> 15) & 1;
-		
 				x = 8 * mx;
 				x += xOffs;
-			
-				Code = Attr & 0x1fff;
-				Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-				Code &= (System16NumTiles - 1);
-				Colour = (Attr >> 6) & 0x7f;
-			
-				ColourOff = System16TilemapColorOffset;
-				if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-				if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-				if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-		
-				if (Priority == 0) RenderTile_Mask(pSys16FgAltTileMapPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				if (Priority == 1) RenderTile_Mask(pSys16FgAltTileMapPri1, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-			}
-		}
-	}
-}
 
-static void System16BAltCreateBgTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, i, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	UINT16 *pDest = NULL;
-		
-	if (System16CreateOpaqueTileMaps) memset(pSys16BgTileMapOpaque, 0, 1024 * 512 * sizeof(UINT16));
-	EffPage = System16Page[1];
-	for (i = 0; i < 2; i++) {
-		if (i == 0) pDest = pSys16BgTileMapPri0;
-		if (i == 1) pDest = pSys16BgTileMapPri1;
-		memset(pDest, 0, 1024 * 512 * sizeof(UINT16));
-		for (TilePage = 0; TilePage < 4; TilePage++) {
-			ActPage = (EffPage >> 0) & 0x0f;
-			xOffs = 0;
-			yOffs = 0;
-			if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-			if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-			if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-			for (my = 0; my < 32; my++) {
-				y = 8 * my;
-				y += yOffs;
-				for (mx = 0; mx < 64; mx++) {
-					TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-						
-					Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-					Priority = (Attr >> 15) & 1;
-			
-					if (Priority != i) continue;
-					
-					x = 8 * mx;
-					x += xOffs;
-								
-					Code = Attr & 0x1fff;
-					Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-					Code &= (System16NumTiles - 1);
-					Colour = (Attr >> 5) & 0x7f;
-				
-					ColourOff = System16TilemapColorOffset;
-					if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-					if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-					if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-			
-					if (System16CreateOpaqueTileMaps) RenderTile(pSys16BgTileMapOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
-					RenderTile_Mask(pDest, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				}
-			}
-		}
-	}
-}
+				if (!TileCacheCheck(nCache, (y / 8) * 128 + (x / 8), Code, (Colour << 24) | (Priority << 23) | (ColourOff & 0x7fffff))) continue;
 
-static void System16BAltCreateBgAltTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, i, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	UINT16 *pDest = NULL;
-	
-	if (System16CreateOpaqueTileMaps) memset(pSys16BgAltTileMapOpaque, 0, 1024 * 512 * sizeof(UINT16));
-	EffPage = System16Page[3];
-	for (i = 0; i < 2; i++) {
-		if (i == 0) pDest = pSys16BgAltTileMapPri0;
-		if (i == 1) pDest = pSys16BgAltTileMapPri1;
-		if (System16RecalcBgAltTileMap) memset(pDest, 0,1024 * 512 * sizeof(UINT16));
-		for (TilePage = 0; TilePage < 4; TilePage++) {
-			ActPage = (EffPage >> 0) & 0x0f;
-			xOffs = 0;
-			yOffs = 0;
-			if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-			if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-			if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-			for (my = 0; my < 32; my++) {
-				y = 8 * my;
-				y += yOffs;
-				for (mx = 0; mx < 64; mx++) {
-					TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-						
-					Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-					Priority = (Attr >> 15) & 1;
-			
-					if (Priority != i) continue;
-					
-					x = 8 * mx;
-					x += xOffs;
-			
-					Code = Attr & 0x1fff;
-					Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-					Code &= (System16NumTiles - 1);
-					Colour = (Attr >> 5) & 0x7f;
-				
-					ColourOff = System16TilemapColorOffset;
-					if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-					if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-					if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-			
-					if (System16CreateOpaqueTileMaps) RenderTile(pSys16BgAltTileMapOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
-					if (System16RecalcBgAltTileMap) RenderTile_Mask(pDest, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				}
-			}
-		}
-	}
-}
+				System16ClearTile(pPri0, x, y);
+				System16ClearTile(pPri1, x, y);
 
-static void System16BAltCreateFgTileMaps()
-{
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	
-	memset(pSys16FgTileMapPri0, 0, 1024 * 512 * sizeof(UINT16));
-	memset(pSys16FgTileMapPri1, 0, 1024 * 512 * sizeof(UINT16));
-		
-	EffPage = System16Page[0];
-	for (TilePage = 0; TilePage < 4; TilePage++) {
-		ActPage = (EffPage >> 0) & 0x0f;
-		xOffs = 0;
-		yOffs = 0;
-		if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-		if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-		if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-		for (my = 0; my < 32; my++) {
-			y = 8 * my;
-			y += yOffs;
-			for (mx = 0; mx < 64; mx++) {
-				TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-					
-				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-				Priority = (Attr >> 15) & 1;
-			
-				x = 8 * mx;
-				x += xOffs;
-			
-				Code = Attr & 0x1fff;
-				Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-				Code &= (System16NumTiles - 1);
-				Colour = (Attr >> 5) & 0x7f;
-			
-				ColourOff = System16TilemapColorOffset;
-				if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-				if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-				if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-		
-				if (Priority == 0) RenderTile_Mask(pSys16FgTileMapPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				if (Priority == 1) RenderTile_Mask(pSys16FgTileMapPri1, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
+				if (pOpaque) RenderTile(pOpaque, Code, x, y, Colour, 3, ColourOff, System16Tiles);
+				RenderTile_Mask(Priority ? pPri1 : pPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
 			}
 		}
 	}
 }
 
-static void System16BAltCreateFgAltTileMaps()
+static UINT16 System16AEffPage(INT32 nPage)
 {
-	INT32 mx, my, Attr, Code, Colour, x, y, TileIndex, Priority, ColourOff, TilePage, xOffs, yOffs;
-	UINT16 *VideoRam = (UINT16*)System16TileRam;
-	UINT16 EffPage, ActPage;
-	
-	memset(pSys16FgAltTileMapPri0, 0, 1024 * 512 * sizeof(UINT16));
-	memset(pSys16FgAltTileMapPri1, 0, 1024 * 512 * sizeof(UINT16));
-		
-	EffPage = System16Page[2];
-	for (TilePage = 0; TilePage < 4; TilePage++) {
-		ActPage = (EffPage >> 0) & 0x0f;
-		xOffs = 0;
-		yOffs = 0;
-		if (TilePage == 1) { ActPage = (EffPage >> 4) & 0x0f; xOffs = 512; }
-		if (TilePage == 2) { ActPage = (EffPage >> 8) & 0x0f; yOffs = 256; }
-		if (TilePage == 3) { ActPage = (EffPage >> 12) & 0x0f; xOffs = 512; yOffs = 256; }
-		for (my = 0; my < 32; my++) {
-			y = 8 * my;
-			y += yOffs;
-			for (mx = 0; mx < 64; mx++) {
-				TileIndex = (ActPage * 64 * 32) + (my * 64) + mx;
-					
-				Attr = BURN_ENDIAN_SWAP_INT16(VideoRam[TileIndex]);
-				Priority = (Attr >> 15) & 1;
-		
-				x = 8 * mx;
-				x += xOffs;
-			
-				Code = Attr & 0x1fff;
-				Code = System16TileBanks[Code / System16TileBankSize] * System16TileBankSize + Code % System16TileBankSize;
-				Code &= (System16NumTiles - 1);
-				Colour = (Attr >> 5) & 0x7f;
-			
-				ColourOff = System16TilemapColorOffset;
-				if (Colour >= 0x20) ColourOff = 0x100 | System16TilemapColorOffset;
-				if (Colour >= 0x40) ColourOff = 0x200 | System16TilemapColorOffset;
-				if (Colour >= 0x60) ColourOff = 0x300 | System16TilemapColorOffset;
-		
-				if (Priority == 0) RenderTile_Mask(pSys16FgAltTileMapPri0, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-				if (Priority == 1) RenderTile_Mask(pSys16FgAltTileMapPri1, Code, x, y, Colour, 3, 0, ColourOff, System16Tiles);
-			}
-		}
-	}
+	UINT16 EffPage = System16Page[nPage];
+
+	EffPage = ((EffPage >> 4) & 0x0707) | ((EffPage << 4) & 0x7070);
+	if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SEGA_HANGON) EffPage &= 0x3333;
+
+	return EffPage;
 }
 
 static void System16ACreateTileMaps()
 {
 	if (System16RecalcBgTileMap) {
-		System16ACreateBgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_BG, SYS16_TILES_A, System16AEffPage(1), pSys16BgTileMapPri0, pSys16BgTileMapPri1, System16CreateOpaqueTileMaps ? pSys16BgTileMapOpaque : NULL);
 		System16RecalcBgTileMap = 0;
 	}
 	
 	if (System16RecalcFgTileMap) {
-		System16ACreateFgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_FG, SYS16_TILES_A, System16AEffPage(0), pSys16FgTileMapPri0, pSys16FgTileMapPri1, NULL);
 		System16RecalcFgTileMap = 0;
 	}
 }
@@ -754,22 +354,22 @@ static void System16BCreateTileMaps()
 	}
 
 	if (System16RecalcBgTileMap) {
-		System16BCreateBgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_BG, SYS16_TILES_B, System16Page[1], pSys16BgTileMapPri0, pSys16BgTileMapPri1, System16CreateOpaqueTileMaps ? pSys16BgTileMapOpaque : NULL);
 		System16RecalcBgTileMap = 0;
 	}
 	
 	if (System16RecalcBgAltTileMap) {
-		System16BCreateBgAltTileMaps();
+		System16CreateTileMap(SYS16_CACHE_BGALT, SYS16_TILES_B, System16Page[3], pSys16BgAltTileMapPri0, pSys16BgAltTileMapPri1, System16CreateOpaqueTileMaps ? pSys16BgAltTileMapOpaque : NULL);
 		System16RecalcBgAltTileMap = 0;
 	}
 	
 	if (System16RecalcFgTileMap) {
-		System16BCreateFgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_FG, SYS16_TILES_B, System16Page[0], pSys16FgTileMapPri0, pSys16FgTileMapPri1, NULL);
 		System16RecalcFgTileMap = 0;
 	}
 	
 	if (System16RecalcFgAltTileMap) {
-		System16BCreateFgAltTileMaps();
+		System16CreateTileMap(SYS16_CACHE_FGALT, SYS16_TILES_B, System16Page[2], pSys16FgAltTileMapPri0, pSys16FgAltTileMapPri1, NULL);
 		System16RecalcFgAltTileMap = 0;
 	}
 }
@@ -795,22 +395,22 @@ static void System16BAltCreateTileMaps()
 	}
 
 	if (System16RecalcBgTileMap) {
-		System16BAltCreateBgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_BG, SYS16_TILES_BALT, System16Page[1], pSys16BgTileMapPri0, pSys16BgTileMapPri1, System16CreateOpaqueTileMaps ? pSys16BgTileMapOpaque : NULL);
 		System16RecalcBgTileMap = 0;
 	}
 	
 	if (System16RecalcBgAltTileMap) {
-		System16BAltCreateBgAltTileMaps();
+		System16CreateTileMap(SYS16_CACHE_BGALT, SYS16_TILES_BALT, System16Page[3], pSys16BgAltTileMapPri0, pSys16BgAltTileMapPri1, System16CreateOpaqueTileMaps ? pSys16BgAltTileMapOpaque : NULL);
 		System16RecalcBgAltTileMap = 0;
 	}
 	
 	if (System16RecalcFgTileMap) {
-		System16BAltCreateFgTileMaps();
+		System16CreateTileMap(SYS16_CACHE_FG, SYS16_TILES_BALT, System16Page[0], pSys16FgTileMapPri0, pSys16FgTileMapPri1, NULL);
 		System16RecalcFgTileMap = 0;
 	}
 	
 	if (System16RecalcFgAltTileMap) {
-		System16BAltCreateFgAltTileMaps();
+		System16CreateTileMap(SYS16_CACHE_FGALT, SYS16_TILES_BALT, System16Page[2], pSys16FgAltTileMapPri0, pSys16FgAltTileMapPri1, NULL);
 		System16RecalcFgAltTileMap = 0;
 	}
 }
@@ -3008,6 +2608,8 @@ inline static void System16AUpdateTileValues()
 
 void System16ARender()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (!System16VideoEnable) {
 		BurnTransferClear();
 		return;
@@ -3033,6 +2635,8 @@ void System16ARender()
 
 void System16BootlegRender()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (!System16VideoEnable) {
 		BurnTransferClear();
 		return;
@@ -3084,6 +2688,8 @@ inline static void System16BUpdateTileValues()
 
 void System16BRender()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (!System16IgnoreVideoEnable) {
 		if (!System16VideoEnable) {
 			BurnTransferClear();
@@ -3111,6 +2717,8 @@ void System16BRender()
 
 void System16BAltRender()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (!System16VideoEnable) {
 		BurnTransferClear();
 		return;
@@ -3136,6 +2744,8 @@ void System16BAltRender()
 
 void System18Render()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (!System16VideoEnable) {
 		BurnTransferClear();
 		return;
@@ -289,6 +289,8 @@ void ToaBufferFCU2Sprites()
 
 INT32 ToaRenderBCU2()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (nLastBPP != nBurnBpp ) {
 		nLastBPP = nBurnBpp;
 
@@ -387,6 +387,8 @@ INT32 ToaBufferGP9001Sprites()
 
 INT32 ToaRenderGP9001()
 {
+	BURN_PROF_SCOPE(BURN_PROF_DRAW);
+
 	if (nLastBPP != nBurnBpp ) {
 		nLastBPP = nBurnBpp;
 
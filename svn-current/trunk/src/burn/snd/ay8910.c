@@ -13,6 +13,7 @@
 #include "driver.h"
 #include "state.h"
 #include "ay8910.h"
+#include "burn_prof.h"
 
 #if defined FBA_DEBUG
 #ifdef __GNUC__ 
@@ -361,6 +362,8 @@ void AY8910Update(INT32 chip, INT16 **buffer, INT32 length)
 #endif
 #endif
 
+	BURN_PROF_ENTER(BURN_PROF_SOUND_PSG);
+
 	buf1 = buffer[0];
 	buf2 = buffer[1];
 	buf3 = buffer[2];
@@ -616,6 +619,8 @@ void AY8910Update(INT32 chip, INT16 **buffer, INT32 length)
 
 		length--;
 	}
+
+	BURN_PROF_LEAVE();
 }
 
 
@@ -856,6 +861,8 @@ void AY8910Render(INT16** buffer, INT16* dest, INT32 length, INT32 bAddSignal)
 	INT16 *buf2 = buffer[2];
 	INT16 *buf3, *buf4, *buf5, *buf6, *buf7, *buf8, *buf9, *buf10, *buf11, *buf12, *buf13, *buf14, *buf15, *buf16, *buf17;
 	INT32 n;
+
+	BURN_PROF_ENTER(BURN_PROF_SOUND_PSG);
 	
 	for (i = 0; i < num; i++) {
 		AY8910Update(i, buffer + (i * 3), length);
@@ -935,6 +942,8 @@ void AY8910Render(INT16** buffer, INT16* dest, INT32 length, INT32 bAddSignal)
 			dest[(n << 1) + 1] = nRightSample;
 		}
 	}
+
+	BURN_PROF_LEAVE();
 }
 
 void AY8910SetRoute(INT32 chip, INT32 nIndex, double nVolume, INT32 nRouteDir)
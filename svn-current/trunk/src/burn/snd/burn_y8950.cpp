@@ -325,6 +325,8 @@ static void Y8950Render(INT32 nSegmentLength)
 	if (!DebugSnd_Y8950Initted) bprintf(PRINT_ERROR, _T("Y8950Render called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nY8950Position >= nSegmentLength) {
 		return;
 	}
@@ -349,6 +351,8 @@ static void Y8950UpdateResample(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_Y8950Initted) bprintf(PRINT_ERROR, _T("Y8950UpdateResample called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 nSamplesNeeded = nSegmentEnd * nBurnY8950SoundRate / nBurnSoundRate + 1;
 
@@ -441,6 +445,8 @@ static void Y8950UpdateNormal(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_Y8950Initted) bprintf(PRINT_ERROR, _T("Y8950UpdateNormal called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 
 	if (nSegmentEnd < nY8950Position) {
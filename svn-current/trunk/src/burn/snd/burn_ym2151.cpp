@@ -25,6 +25,8 @@ static void YM2151RenderResample(INT16* pSoundBuf, INT32 nSegmentLength)
 #if defined FBA_DEBUG
 	if (!DebugSnd_YM2151Initted) bprintf(PRINT_ERROR, _T("YM2151RenderResample called without init\n"));
 #endif
+
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
 	
 	nBurnPosition += nSegmentLength;
 
@@ -109,6 +111,8 @@ static void YM2151RenderNormal(INT16* pSoundBuf, INT32 nSegmentLength)
 	if (!DebugSnd_YM2151Initted) bprintf(PRINT_ERROR, _T("YM2151RenderNormal called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	nBurnPosition += nSegmentLength;
 
 	pYM2151Buffer[0] = pBuffer;
@@ -53,6 +53,8 @@ static void AY8910Render(INT32 nSegmentLength)
 	if (!DebugSnd_YM2203Initted) bprintf(PRINT_ERROR, _T("BurnYM2203 AY8910Render called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nAY8910Position >= nSegmentLength) {
 		return;
 	}
@@ -82,6 +84,8 @@ static void YM2203Render(INT32 nSegmentLength)
 	if (!DebugSnd_YM2203Initted) bprintf(PRINT_ERROR, _T("YM2203Render called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nYM2203Position >= nSegmentLength) {
 		return;
 	}
@@ -138,6 +142,8 @@ static void YM2203UpdateResample(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2203Initted) bprintf(PRINT_ERROR, _T("YM2203UpdateResample called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 nSamplesNeeded = nSegmentEnd * nBurnYM2203SoundRate / nBurnSoundRate + 1;
 
@@ -265,6 +271,8 @@ static void YM2203UpdateNormal(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2203Initted) bprintf(PRINT_ERROR, _T("YM2203UpdateNormal called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 i;
 
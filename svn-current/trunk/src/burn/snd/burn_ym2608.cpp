@@ -46,6 +46,8 @@ static void AY8910Render(INT32 nSegmentLength)
 	if (!DebugSnd_YM2608Initted) bprintf(PRINT_ERROR, _T("BurnYM2608 AY8910Render called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nAY8910Position >= nSegmentLength) {
 		return;
 	}
@@ -67,6 +69,8 @@ static void YM2608Render(INT32 nSegmentLength)
 	if (!DebugSnd_YM2608Initted) bprintf(PRINT_ERROR, _T("YM2608Render called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nYM2608Position >= nSegmentLength) {
 		return;
 	}
@@ -90,6 +94,8 @@ static void YM2608UpdateResample(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2608Initted) bprintf(PRINT_ERROR, _T("YM2608UpdateResample called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 nSamplesNeeded = nSegmentEnd * nBurnYM2608SoundRate / nBurnSoundRate + 1;
 
@@ -204,6 +210,8 @@ static void YM2608UpdateNormal(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2608Initted) bprintf(PRINT_ERROR, _T("YM2608UpdateNormal called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 
 	if (nSegmentEnd < nAY8910Position) {
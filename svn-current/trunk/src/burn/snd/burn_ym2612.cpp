@@ -45,6 +45,8 @@ static void YM2612Render(INT32 nSegmentLength)
 #if defined FBA_DEBUG
 	if (!DebugSnd_YM2612Initted) bprintf(PRINT_ERROR, _T("YM2612Render called without init\n"));
 #endif
+
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
 	
 	if (nYM2612Position >= nSegmentLength) {
 		return;
@@ -93,6 +95,8 @@ static void YM2612UpdateResample(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2612Initted) bprintf(PRINT_ERROR, _T("YM2612UpdateResample called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 nSamplesNeeded = nSegmentEnd * nBurnYM2612SoundRate / nBurnSoundRate + 1;
 
@@ -172,6 +176,8 @@ static void YM2612UpdateNormal(INT16* pSoundBuf, INT32 nSegmentEnd)
 	if (!DebugSnd_YM2612Initted) bprintf(PRINT_ERROR, _T("YM2612UpdateNormal called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT32 nSegmentLength = nSegmentEnd;
 	INT32 i;
 
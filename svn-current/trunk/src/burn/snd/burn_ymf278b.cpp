@@ -31,6 +31,8 @@ static void YMF278BRender(INT32 nSegmentLength)
 	if (!DebugSnd_YMF278BInitted) bprintf(PRINT_ERROR, _T("YMF278BRender called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	if (nYMF278BPosition >= nSegmentLength) {
 		return;
 	}
@@ -56,6 +58,8 @@ void BurnYMF278BUpdate(INT32 nSegmentEnd)
 	if (!DebugSnd_YMF278BInitted) bprintf(PRINT_ERROR, _T("BurnYMF278BUpdate called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_FM);
+
 	INT16* pSoundBuf = pBurnSoundOut;
 	INT32 nSegmentLength = nSegmentEnd;
 
@@ -377,6 +377,8 @@ static void c6280_write_internal(int offset, int data)
 
 void c6280_update(INT16 *pBuffer, INT32 samples)
 {
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	c6280_t *p = &chip[0];
 
 	c6280_stream_update();
@@ -71,6 +71,8 @@ void DACUpdate(INT16* Buffer, INT32 Length)
 	if (!DebugSnd_DACInitted) bprintf(PRINT_ERROR, _T("DACUpdate called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	struct dac_info *ptr;
 
 	for (INT32 i = 0; i < NumChips; i++) {
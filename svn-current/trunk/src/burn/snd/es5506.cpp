@@ -857,6 +857,8 @@ void ES5506Update(INT16 *pBuffer, INT32 samples)
 	if (!DebugSnd_ES5506Initted) bprintf(PRINT_ERROR, _T("ES5506Update called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 //	es5506_state *chip = (es5506_state *)param;
 	INT32 *lsrc = chip->scratch, *rsrc = chip->scratch;
 //	short *ldest = &pBuffer[0];
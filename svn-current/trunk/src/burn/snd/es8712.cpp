@@ -182,6 +182,8 @@ void es8712Update(INT32 device, INT16 *buffer, INT32 samples)
 	if (!DebugSnd_ES8712Initted) bprintf(PRINT_ERROR, _T("es8712Update called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	if (device >= MAX_ES8712_CHIPS) return;
 
 	chip = &chips[device];
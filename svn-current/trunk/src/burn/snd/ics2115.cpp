@@ -404,6 +404,8 @@ void ics2115_update(INT32 /*length*/)
 	if (!DebugSnd_ICS2115Initted) bprintf(PRINT_ERROR, _T("ics2115_update called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	INT32 rec_irq = 0;
 	
 	//short* pSoundBuf = pBurnSoundOut;
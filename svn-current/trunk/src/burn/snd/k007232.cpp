@@ -51,6 +51,8 @@ void K007232Update(INT32 chip, INT16* pSoundBuf, INT32 nLength)
 	if (chip >nNumChips) bprintf(PRINT_ERROR, _T("K007232Update called with invalid chip %x\n"), chip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	INT32 i;
 
 	Chip = &Chips[chip];
@@ -91,6 +91,8 @@ void K051649Update(INT16 *pBuf, INT32 samples)
 	if (!DebugSnd_K051649Initted) bprintf(PRINT_ERROR, _T("K051649Update called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	info = &Chips[0];
 	k051649_sound_channel *voice=info->channel_list;
 	INT16 *mix;
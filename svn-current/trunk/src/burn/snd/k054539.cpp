@@ -367,6 +367,8 @@ void K054539Update(INT32 chip, INT16 *pBuf, INT32 length)
 	if (chip > nNumChips) bprintf(PRINT_ERROR, _T("K054539Update called with invalid chip %x\n"), chip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	info = &Chips[chip];
 #define VOL_CAP 1.80
 
@@ -179,6 +179,8 @@ void MSM5205Render(INT32 chip, INT16 *buffer, INT32 len)
 	if (chip > nNumChips) bprintf(PRINT_ERROR, _T("MSM5205Render called with invalid chip %x\n"), chip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	voice = &chips[chip];
 	INT16 *source = stream[chip];
 
@@ -312,6 +312,8 @@ INT32 MSM6295Render(INT32 nChip, INT16* pSoundBuf, INT32 nSegmentLength)
 	if (nChip > nLastMSM6295Chip) bprintf(PRINT_ERROR, _T("MSM6295Render called with invalid chip number %x\n"), nChip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	if (nChip == 0) {
 		memset(pLeftBuffer, 0, nSegmentLength * sizeof(INT32));
 		memset(pRightBuffer, 0, nSegmentLength * sizeof(INT32));
@@ -120,6 +120,8 @@ void NamcoSoundUpdate(INT16* buffer, INT32 length)
 	if (!DebugSnd_NamcoSndInitted) bprintf(PRINT_ERROR, _T("NamcoSoundUpdate called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	sound_channel *voice;
 
 	/* zap the contents of the buffer */
@@ -203,6 +205,8 @@ void NamcoSoundUpdateStereo(INT16* buffer, INT32 length)
 	if (!DebugSnd_NamcoSndInitted) bprintf(PRINT_ERROR, _T("NamcoSoundUpdateStereo called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	sound_channel *voice;
 
 	/* zap the contents of the buffers */
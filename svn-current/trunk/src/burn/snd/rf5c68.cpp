@@ -39,6 +39,8 @@ void RF5C68PCMUpdate(INT16* pSoundBuf, INT32 length)
 	if (!DebugSnd_RF5C68Initted) bprintf(PRINT_ERROR, _T("RF5C68PCMUpdate called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	if (!chip->enable) return;
 	
 	INT32 i, j;
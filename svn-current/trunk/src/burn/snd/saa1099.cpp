@@ -217,6 +217,8 @@ void saa1099Update(INT32 chip, INT16 *output, INT32 samples)
 	if (chip > nNumChips) bprintf(PRINT_ERROR, _T("saa1099Update called with invalid chip %x\n"), chip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	saa1099_state *saa = &chips[chip];
 	INT32 j, ch;
 
@@ -388,6 +388,8 @@ void BurnSampleRender(INT16 *pDest, UINT32 pLen)
 	if (!DebugSnd_SamplesInitted) bprintf(PRINT_ERROR, _T("BurnSampleRender called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	if (pBurnSoundOut == NULL) return;
 
 	INT32 nFirstSample = 0;
@@ -70,6 +70,8 @@ void SegaPCMUpdate(INT16* pSoundBuf, INT32 nLength)
 	if (!DebugSnd_SegaPCMInitted) bprintf(PRINT_ERROR, _T("SegaPCMUpdate called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	for (INT32 i = 0; i < nNumChips + 1; i++) {
 		SegaPCMUpdateOne(i, nLength);
 	}
@@ -42,6 +42,8 @@ void SN76496Update(INT32 Num, INT16* pSoundBuf, INT32 Length)
 	if (Num > NumChips) bprintf(PRINT_ERROR, _T("SN76496Update called with invalid chip %x\n"), Num);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PSG);
+
 	INT32 i;
 	struct SN76496 *R = Chip0;
 	
@@ -320,6 +320,8 @@ void UPD7759Update(INT32 chip, INT16 *pSoundBuf, INT32 nLength)
 	if (chip > nNumChips) bprintf(PRINT_ERROR, _T("UPD7759Update called with invalid chip %x\n"), chip);
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	Chip = Chips[chip];
 
 	INT32 ClocksLeft = Chip->clocks_left;
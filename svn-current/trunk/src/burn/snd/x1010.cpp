@@ -54,6 +54,8 @@ void x1010_sound_update()
 	if (!DebugSnd_X1010Initted) bprintf(PRINT_ERROR, _T("x1010_sound_update called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SOUND_PCM);
+
 	INT16* pSoundBuf = pBurnSoundOut;
 	memset(pSoundBuf, 0, nBurnSoundLen * sizeof(INT16) * 2);
 
@@ -33,6 +33,23 @@ struct BurnArea { void *Data; UINT32 nLen; INT32 nAddress; char *szName; };
 /* Application-defined callback for processing the area */
 extern INT32 (__cdecl *BurnAcb) (struct BurnArea* pba);
 
+/* Sizes and names of the areas a full scan visits (Data is always NULL), returns the total size */
+UINT32 BurnAreaLayout(struct BurnArea** ppArea, INT32* pnCount);
+
+/* Record the areas again on the next BurnAreaLayout(), call it when a scan no longer matches the recorded layout */
+void BurnAreaLayoutInvalidate();
+
+/* Copy the whole state of the running machine to or from memory, return 1 if it doesn't take nLen bytes exactly */
+INT32 BurnAreaSave(UINT8* pDest, UINT32 nLen);
+INT32 BurnAreaLoad(const UINT8* pSrc, UINT32 nLen);
+
+/* Copies of the active driver's machine, run one at a time by loading each before its frame */
+struct BurnInstance;
+struct BurnInstance* BurnInstanceCreate();
+INT32 BurnInstanceSave(struct BurnInstance* pInstance);
+INT32 BurnInstanceLoad(struct BurnInstance* pInstance);
+void BurnInstanceFree(struct BurnInstance* pInstance);
+
 /* Scan a small variable or structure */
 static void ScanVar(void* pv, INT32 nSize, char* szName)
 {
@@ -0,0 +1,49 @@
+// Tile cache
+
+#include "burnint.h"
+#include "tiles_cache.h"
+
+static UINT32 *TileCacheKeys[TILE_CACHE_MAX];	// Code and attributes of each tile, two words per tile
+static INT32 TileCacheTiles[TILE_CACHE_MAX];
+
+INT32 TileCacheInit(INT32 nCache, INT32 nTiles)
+{
+	if (nCache < 0 || nCache >= TILE_CACHE_MAX) return 1;
+
+	BurnFree(TileCacheKeys[nCache]);
+
+	TileCacheKeys[nCache] = (UINT32*)BurnMalloc(nTiles * 2 * sizeof(UINT32));
+	if (TileCacheKeys[nCache] == NULL) return 1;
+
+	TileCacheTiles[nCache] = nTiles;
+	TileCacheDirty(nCache);
+
+	return 0;
+}
+
+void TileCacheExit()
+{
+	for (INT32 i = 0; i < TILE_CACHE_MAX; i++) {
+		BurnFree(TileCacheKeys[i]);
+		TileCacheTiles[i] = 0;
+	}
+}
+
+void TileCacheDirty(INT32 nCache)
+{
+	if (TileCacheKeys[nCache]) {
+		memset(TileCacheKeys[nCache], 0xff, TileCacheTiles[nCache] * 2 * sizeof(UINT32));
+	}
+}
+
+INT32 TileCacheCheck(INT32 nCache, INT32 nTile, UINT32 nCode, UINT32 nAttr)
+{
+	UINT32 *pKey = TileCacheKeys[nCache] + (nTile * 2);
+
+	if (pKey[0] == nCode && pKey[1] == nAttr) return 0;
+
+	pKey[0] = nCode;
+	pKey[1] = nAttr;
+
+	return 1;
+}
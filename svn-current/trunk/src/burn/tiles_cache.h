@@ -0,0 +1,22 @@
+#ifndef _TILES_CACHE_H
+#define _TILES_CACHE_H
+
+// Tile cache
+
+// Remembers what every tile of a pre-rendered tilemap was last drawn with, so
+// only the tiles that changed have to be redrawn. The attributes are compared
+// rather than tracked from the video ram writes, as they also depend on bank
+// and page registers.
+
+#define TILE_CACHE_MAX		(8)
+
+INT32 TileCacheInit(INT32 nCache, INT32 nTiles);
+void TileCacheExit();
+
+// Every tile is redrawn the next time it is checked
+void TileCacheDirty(INT32 nCache);
+
+// Returns 1 (and keeps the new attributes) if the tile has to be redrawn
+INT32 TileCacheCheck(INT32 nCache, INT32 nTile, UINT32 nCode, UINT32 nAttr);
+
+#endif
@@ -54,11 +54,166 @@ inline static INT32 readbit(const UINT8 *src, INT32 bitnum)
 	return src[bitnum / 8] & (0x80 >> (bitnum % 8));
 }
 
-void GfxDecode(INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+// The layout tables are checked once per call and the tiles are decoded with the
+// fastest of three loops:
+//  - packed: each pixel is 1, 2, 4 or 8 neighbouring bits (planes in order), read in one go
+//  - aligned: the rows of each plane start at the same bit of a byte, so runs of 8 or 4
+//    neighbouring bits are spread over the pixels with one table lookup and the other
+//    pixels use a precomputed byte and mask
+//  - generic: bit by bit
+
+struct GfxPlanPixel {
+	INT32 nByte;
+	UINT8 nMask;					// Bit of a single pixel, 0 for a run
+	UINT8 nRun;						// Pixels read in one go: 1, 4 or 8
+	UINT8 nShift;					// Shift of a run of 4 within its byte
+};
+
+static UINT8 GfxExpand[256][8];		// The bits of a byte as 0/1 pixels, msb first
+static INT32 GfxExpandInitted = 0;
+
+static void GfxExpandInit()
+{
+	for (INT32 i = 0; i < 256; i++) {
+		for (INT32 x = 0; x < 8; x++) {
+			GfxExpand[i][x] = (i >> (7 - x)) & 1;
+		}
+	}
+
+	GfxExpandInitted = 1;
+}
+
+static INT32 GfxPlanPacked(INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo)
+{
+	if (numPlanes != 1 && numPlanes != 2 && numPlanes != 4 && numPlanes != 8) return 0;
+	if (planeoffsets[0] < 0 || (planeoffsets[0] % numPlanes) || (modulo % numPlanes)) return 0;
+
+	for (INT32 plane = 1; plane < numPlanes; plane++) {
+		if (planeoffsets[plane] != planeoffsets[0] + plane) return 0;
+	}
+	for (INT32 y = 0; y < ySize; y++) {
+		if (yoffsets[y] < 0 || (yoffsets[y] % numPlanes)) return 0;
+	}
+	for (INT32 x = 0; x < xSize; x++) {
+		if (xoffsets[x] < 0 || (xoffsets[x] % numPlanes)) return 0;
+	}
+
+	return 1;
+}
+
+static INT32 GfxPlanAligned(INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo)
+{
+	if (numPlanes > 8 || modulo < 0 || (modulo & 7)) return 0;
+
+	for (INT32 plane = 0; plane < numPlanes; plane++) {
+		if (planeoffsets[plane] < 0) return 0;
+	}
+	for (INT32 y = 0; y < ySize; y++) {
+		if (yoffsets[y] < 0 || (yoffsets[y] & 7)) return 0;
+	}
+	for (INT32 x = 0; x < xSize; x++) {
+		if (xoffsets[x] < 0) return 0;
+	}
+
+	return 1;
+}
+
+static void GfxPlanPixels(struct GfxPlanPixel *pPlan, INT32 nBit, INT32 xSize, INT32 xoffsets[])
+{
+	for (INT32 x = 0; x < xSize; ) {
+		INT32 bit = nBit + xoffsets[x];
+		INT32 run = 1;
+
+		for (INT32 len = 8; len >= 4 && run == 1; len -= 4) {
+			if ((x % len) || x + len > xSize || (bit % len)) continue;
+
+			INT32 i;
+			for (i = 1; i < len; i++) {
+				if (nBit + xoffsets[x + i] != bit + i) break;
+			}
+			if (i == len) run = len;
+		}
+
+		pPlan[x].nByte = bit >> 3;
+		pPlan[x].nMask = (run == 1) ? (0x80 >> (bit & 7)) : 0;
+		pPlan[x].nRun = run;
+		pPlan[x].nShift = 4 - (bit & 4);
+
+		x += run;
+	}
+}
+
+static void GfxDecodePacked(INT32 first, INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+{
+	INT32 mask = (1 << numPlanes) - 1;
+
+	for (INT32 c = first; c < first + num; c++) {
+		UINT8 *dp = pDest + (c * xSize * ySize);
+
+		for (INT32 y = 0; y < ySize; y++, dp += xSize) {
+			INT32 yoffs = (c * modulo) + planeoffsets[0] + yoffsets[y];
+
+			for (INT32 x = 0; x < xSize; x++) {
+				INT32 bit = yoffs + xoffsets[x];
+				dp[x] = (pSrc[bit >> 3] >> (8 - numPlanes - (bit & 7))) & mask;
+			}
+		}
+	}
+}
+
+// pPlans holds xSize pixels for each plane, made by GfxPlanPixels()
+static void GfxDecodeAligned(INT32 first, INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 yoffsets[], INT32 modulo, struct GfxPlanPixel *pPlans, UINT8 *pSrc, UINT8 *pDest)
+{
+	for (INT32 c = first; c < first + num; c++) {
+		UINT8 *dp = pDest + (c * xSize * ySize);
+		memset(dp, 0, xSize * ySize);
+
+		for (INT32 plane = 0; plane < numPlanes; plane++) {
+			struct GfxPlanPixel *pPlan = pPlans + (plane * xSize);
+			UINT32 planebit = 1 << (numPlanes - 1 - plane);
+			UINT8 *sp = pSrc + (((c * modulo) + planeoffsets[plane]) >> 3);
+
+			for (INT32 y = 0; y < ySize; y++) {
+				UINT8 *src = sp + (yoffsets[y] >> 3);
+				UINT8 *row = dp + (y * xSize);
+
+				for (INT32 x = 0; x < xSize; x += pPlan[x].nRun) {
+					// The expanded bits are 0 or 1 in each byte, so the multiplies can't carry
+					switch (pPlan[x].nRun) {
+						case 1: {
+							if (src[pPlan[x].nByte] & pPlan[x].nMask) row[x] |= planebit;
+							break;
+						}
+
+						case 4: {
+							UINT32 d, e;
+							memcpy(&d, row + x, 4);
+							memcpy(&e, GfxExpand[(src[pPlan[x].nByte] >> pPlan[x].nShift) & 0x0f] + 4, 4);
+							d |= e * planebit;
+							memcpy(row + x, &d, 4);
+							break;
+						}
+
+						case 8: {
+							UINT64 d, e;
+							memcpy(&d, row + x, 8);
+							memcpy(&e, GfxExpand[src[pPlan[x].nByte]], 8);
+							d |= e * planebit;
+							memcpy(row + x, &d, 8);
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+static void GfxDecodeGeneric(INT32 first, INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
 {
 	INT32 c;
 	
-	for (c = 0; c < num; c++) {
+	for (c = first; c < first + num; c++) {
 		INT32 plane, x, y;
 	
 		UINT8 *dp = pDest + (c * xSize * ySize);
@@ -80,26 +235,83 @@ void GfxDecode(INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 plane
 	}	
 }
 
-void GfxDecodeSingle(INT32 which, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+#define GFX_DECODE_PACKED	(0)
+#define GFX_DECODE_ALIGNED	(1)
+#define GFX_DECODE_GENERIC	(2)
+
+#define GFX_CHUNK_TILES		(512)		// Tiles decoded by each job of a split up decode
+
+struct GfxDecodeJob {
+	INT32 nMethod;
+	INT32 first, num;
+	INT32 numPlanes, xSize, ySize;
+	INT32 *planeoffsets, *xoffsets, *yoffsets;
+	INT32 modulo;
+	struct GfxPlanPixel *pPlans;
+	UINT8 *pSrc, *pDest;
+};
+
+static void GfxDecodeChunk(INT32 nIndex, void* pParam)
 {
-	INT32 plane, x, y;
-	
-	UINT8 *dp = pDest + (which * xSize * ySize);
-	memset(dp, 0, xSize * ySize);
-	
-	for (plane = 0; plane < numPlanes; plane++) {
-		INT32 planebit = 1 << (numPlanes - 1 - plane);
-		INT32 planeoffs = (which * modulo) + planeoffsets[plane];
-		
-		for (y = 0; y < ySize; y++) {
-			INT32 yoffs = planeoffs + yoffsets[y];
-			dp = pDest + (which * xSize * ySize) + (y * xSize);
-		
-			for (x = 0; x < xSize; x++) {
-				if (readbit(pSrc, yoffs + xoffsets[x])) dp[x] |= planebit;
+	struct GfxDecodeJob *pJob = (struct GfxDecodeJob*)pParam;
+
+	INT32 first = pJob->first + nIndex * GFX_CHUNK_TILES;
+	INT32 num = pJob->first + pJob->num - first;
+	if (num > GFX_CHUNK_TILES) num = GFX_CHUNK_TILES;
+
+	switch (pJob->nMethod) {
+		case GFX_DECODE_PACKED:
+			GfxDecodePacked(first, num, pJob->numPlanes, pJob->xSize, pJob->ySize, pJob->planeoffsets, pJob->xoffsets, pJob->yoffsets, pJob->modulo, pJob->pSrc, pJob->pDest);
+			break;
+
+		case GFX_DECODE_ALIGNED:
+			GfxDecodeAligned(first, num, pJob->numPlanes, pJob->xSize, pJob->ySize, pJob->planeoffsets, pJob->yoffsets, pJob->modulo, pJob->pPlans, pJob->pSrc, pJob->pDest);
+			break;
+
+		default:
+			GfxDecodeGeneric(first, num, pJob->numPlanes, pJob->xSize, pJob->ySize, pJob->planeoffsets, pJob->xoffsets, pJob->yoffsets, pJob->modulo, pJob->pSrc, pJob->pDest);
+			break;
+	}
+}
+
+static void GfxDecodeRange(INT32 first, INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+{
+	if (num <= 0) return;
+
+	struct GfxDecodeJob Job = { GFX_DECODE_GENERIC, first, num, numPlanes, xSize, ySize, planeoffsets, xoffsets, yoffsets, modulo, NULL, pSrc, pDest };
+
+	if (GfxPlanPacked(numPlanes, xSize, ySize, planeoffsets, xoffsets, yoffsets, modulo)) {
+		Job.nMethod = GFX_DECODE_PACKED;
+	} else if (GfxPlanAligned(numPlanes, xSize, ySize, planeoffsets, xoffsets, yoffsets, modulo)) {
+		Job.pPlans = (struct GfxPlanPixel*)malloc(numPlanes * xSize * sizeof(struct GfxPlanPixel));
+
+		if (Job.pPlans) {
+			if (!GfxExpandInitted) GfxExpandInit();
+
+			for (INT32 plane = 0; plane < numPlanes; plane++) {
+				GfxPlanPixels(Job.pPlans + (plane * xSize), planeoffsets[plane] & 7, xSize, xoffsets);
 			}
+
+			Job.nMethod = GFX_DECODE_ALIGNED;
 		}
 	}
+
+	// Every tile is decoded on its own, so big decodes are split up between the worker threads
+	BurnParallel((num + GFX_CHUNK_TILES - 1) / GFX_CHUNK_TILES, GfxDecodeChunk, &Job);
+
+	if (Job.pPlans) {
+		free(Job.pPlans);
+	}
+}
+
+void GfxDecode(INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+{
+	GfxDecodeRange(0, num, numPlanes, xSize, ySize, planeoffsets, xoffsets, yoffsets, modulo, pSrc, pDest);
+}
+
+void GfxDecodeSingle(INT32 which, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
+{
+	GfxDecodeRange(which, 1, numPlanes, xSize, ySize, planeoffsets, xoffsets, yoffsets, modulo, pSrc, pDest);
 }
 
 //================================================================================================
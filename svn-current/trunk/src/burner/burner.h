@@ -178,6 +178,11 @@ INT32 ZipOpen(char* szZip);
 INT32 ZipClose();
 INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount);
 INT32 ZipLoadFile(UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry);
+INT32 ZipCacheInit();
+INT32 ZipCacheExit();
+void* ZipOpenHandle(char* szZip);
+INT32 ZipLoadFileHandle(void* pZipHandle, UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry);
+void ZipCloseHandle(void* pZipHandle);
 INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, INT32* pnWrote);
 
 // bzip.cpp
@@ -6,9 +6,17 @@
 
 #include "retro_common.h"
 #include "retro_input.h"
+#include "retro_prefetch.h"
+#include "retro_delta.h"
+#include "retro_movie.h"
+#include "burn_prof.h"
 
 #include "cd/cd_interface.h"
 
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
 #define FBA_VERSION "v0.2.97.29" // Sept 16, 2013 (SVN)
 
 #if defined(CPS1_ONLY)
@@ -33,6 +41,9 @@ static void log_dummy(enum retro_log_level level, const char *fmt, ...) { }
 static const char *print_label(unsigned i);
 
 static bool apply_dipswitch_from_variables();
+#ifdef HAVE_THREADS
+static bool PipelineDeferReinit();
+#endif
 
 retro_log_printf_t log_cb = log_dummy;
 retro_environment_t environ_cb;
@@ -88,8 +99,6 @@ static bool  all_diag_input_pressed = true;
 
 unsigned nGameType = 0;
 
-static unsigned int BurnDrvGetIndexByName(const char* name);
-
 extern INT32 EnableHiscores;
 
 #define STAT_NOFIND  0
@@ -106,6 +115,8 @@ struct ROMFIND
 	unsigned int nState;
 	int nArchive;
 	int nPos;
+	UINT32 nFileCrc;   // CRC and size of the file found in the archive, nFileLen is 0 if none
+	UINT32 nFileLen;
    BurnRomInfo ri;
 };
 
@@ -189,6 +200,7 @@ void IpsApplyPatches(UINT8 *, char *) {}
 
 TCHAR szAppHiscorePath[MAX_PATH];
 TCHAR szAppSamplesPath[MAX_PATH];
+TCHAR szAppGfxCachePath[MAX_PATH];
 TCHAR szAppBurnVer[16];
 
 CDEmuStatusValue CDEmuStatus;
@@ -460,6 +472,11 @@ int InputSetCooperativeLevel(const bool bExclusive, const bool bForeGround)
 
 void Reinitialise(void)
 {
+#ifdef HAVE_THREADS
+   if (PipelineDeferReinit())
+      return;
+#endif
+
    // Update the geometry, some games (sfiii2) and systems (megadrive) need it.
    struct retro_system_av_info av_info;
    retro_get_system_av_info(&av_info);
@@ -476,6 +493,312 @@ static void ForceFrameStep()
    BurnDrvFrame();
 }
 
+// Input movie: at load FBNEO_MOVIE_PLAY or FBNEO_MOVIE_RECORD can name the file for
+// scripted runs, otherwise the core option uses <game>.fbm in the save directory.
+// A movie started later begins from a savestate.
+static void MovieStart(bool power_on)
+{
+   char path[MAX_PATH];
+   const char *env;
+
+   if (power_on && (env = getenv("FBNEO_MOVIE_PLAY")) && env[0])
+   {
+      movie_play_start(env, nGameInpCount, power_on);
+      return;
+   }
+
+   if (power_on && (env = getenv("FBNEO_MOVIE_RECORD")) && env[0])
+   {
+      movie_record_start(env, nGameInpCount, power_on);
+      return;
+   }
+
+   movie_stop();
+
+   if (g_opt_movie_mode == MOVIE_MODE_DISABLED)
+      return;
+
+   snprintf(path, sizeof(path), "%s%c%s.fbm", g_save_dir, slash, BurnDrvGetTextA(DRV_NAME));
+
+   if (g_opt_movie_mode == MOVIE_MODE_RECORD)
+      movie_record_start(path, nGameInpCount, power_on);
+   else
+      movie_play_start(path, nGameInpCount, power_on);
+}
+
+#ifdef FBA_PROFILE
+// Profiling builds log where the frame time went each time the profile ring
+// buffer has filled up, and leave the last frames in <game>.prof.csv in the save
+// directory when the game is unloaded. Only the real frames are profiled, the
+// frames run-ahead replays are left out.
+static UINT32 prof_reported = 0;
+
+static void ProfileUpdate()
+{
+   if (BurnProfFrames() - prof_reported >= BURN_PROF_FRAMES)
+   {
+      BurnProfReport();
+      prof_reported = BurnProfFrames();
+   }
+}
+
+static void ProfileDump()
+{
+   char path[MAX_PATH];
+
+   prof_reported = 0;
+
+   if (!BurnProfFrames())
+      return;
+
+   snprintf(path, sizeof(path), "%s%c%s.prof.csv", g_save_dir, slash, BurnDrvGetTextA(DRV_NAME));
+
+   if (BurnProfDump(path, BURN_PROF_CSV))
+      log_cb(RETRO_LOG_ERROR, "[FBA] Can't write the frame profile to %s\n", path);
+   else
+      log_cb(RETRO_LOG_INFO, "[FBA] Frame profile written to %s\n", path);
+}
+#endif
+
+// Run-ahead: the real frame is emulated without drawing it, then the state is
+// kept in a snapshot while the next frames are emulated with the same input,
+// and only the last of those is drawn. Sound always comes from the real frame.
+// The snapshot is a delta state, so after the first frame only the bytes the
+// real frame changed are copied into it.
+static int16_t runahead_audio_buf[AUDIO_SEGMENT_LENGTH * 2];
+
+static bool RunAheadSave()
+{
+   if (delta_state_push())
+      return true;
+
+   // First frame, or the savestate size changed
+   return delta_state_init() && delta_state_push();
+}
+
+static void RunAheadExit()
+{
+   delta_state_exit();
+}
+
+static void RunAheadFrameStep()
+{
+   UINT32 nFrame;
+   unsigned i;
+
+   pBurnDraw = NULL;
+   ForceFrameStep();
+
+   if (!RunAheadSave())
+   {
+      log_cb(RETRO_LOG_WARN, "Can't take a snapshot, run-ahead disabled\n");
+      nRunAhead = 0;
+      pBurnDraw = (uint8_t*)g_fba_frame;
+      BurnDrvRedraw();
+      return;
+   }
+
+   nFrame = nCurrentFrame;
+
+   // The profile only keeps the real frames
+   BURN_PROF_SUSPEND(1);
+
+   for (i = 1; i <= nRunAhead; i++)
+   {
+      pBurnDraw = (i == nRunAhead) ? (uint8_t*)g_fba_frame : NULL;
+      pBurnSoundOut = runahead_audio_buf;
+      nCurrentFrame++;
+
+      BurnDrvFrame();
+   }
+
+   BURN_PROF_SUSPEND(0);
+
+   if (!delta_state_restore())
+   {
+      log_cb(RETRO_LOG_ERROR, "Can't go back to the snapshot, run-ahead disabled\n");
+      nRunAhead = 0;
+   }
+   nCurrentFrame = nFrame;
+}
+
+#ifdef HAVE_THREADS
+// Threaded frames: the next frame is emulated on a worker thread while the
+// frontend presents the last one. Input is read a frame before it's shown, so
+// this adds a frame of latency. The main thread must call PipelineSync() (or
+// PipelineDrop() if the machine is about to be changed) before it touches the
+// machine outside of retro_run.
+static pthread_t pipeline_thread;
+static pthread_mutex_t pipeline_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pipeline_cond = PTHREAD_COND_INITIALIZER;
+static bool pipeline_started = false;
+static bool pipeline_busy = false;     // The worker is emulating a frame
+static bool pipeline_pending = false;  // A finished frame is waiting to be presented
+static bool pipeline_quit = false;
+static bool pipeline_reinit = false;   // The driver called Reinitialise() on the worker
+static uint32_t *pipeline_frame = NULL;
+static int16_t pipeline_audio_buf[AUDIO_SEGMENT_LENGTH * 2];
+
+static void *PipelineWorker(void *)
+{
+   pthread_mutex_lock(&pipeline_lock);
+
+   for (;;)
+   {
+      while (!pipeline_busy && !pipeline_quit)
+         pthread_cond_wait(&pipeline_cond, &pipeline_lock);
+
+      if (pipeline_quit)
+         break;
+
+      pthread_mutex_unlock(&pipeline_lock);
+      ForceFrameStep();
+      pthread_mutex_lock(&pipeline_lock);
+
+      pipeline_busy = false;
+      pthread_cond_broadcast(&pipeline_cond);
+   }
+
+   pthread_mutex_unlock(&pipeline_lock);
+   return NULL;
+}
+
+// The frontend's environment callback is only safe on the main thread
+static bool PipelineDeferReinit()
+{
+   if (!pipeline_started || !pthread_equal(pthread_self(), pipeline_thread))
+      return false;
+
+   pipeline_reinit = true;
+   return true;
+}
+
+static bool PipelineInit()
+{
+   int width, height;
+
+   BurnDrvGetFullSize(&width, &height);
+   pipeline_frame = (uint32_t*)malloc(width * height * sizeof(uint32_t));
+   if (!pipeline_frame)
+      return false;
+
+   pipeline_quit = false;
+   if (pthread_create(&pipeline_thread, NULL, PipelineWorker, NULL))
+   {
+      free(pipeline_frame);
+      pipeline_frame = NULL;
+      return false;
+   }
+
+   pipeline_started = true;
+   return true;
+}
+
+static void PipelineStart()
+{
+   pBurnDraw = (uint8_t*)pipeline_frame;
+
+   pthread_mutex_lock(&pipeline_lock);
+   pipeline_busy = true;
+   pipeline_pending = true;
+   pthread_cond_broadcast(&pipeline_cond);
+   pthread_mutex_unlock(&pipeline_lock);
+}
+
+// Wait for the frame in progress, the machine is idle until the next PipelineStart()
+static void PipelineSync()
+{
+   if (!pipeline_started)
+      return;
+
+   pthread_mutex_lock(&pipeline_lock);
+   while (pipeline_busy)
+      pthread_cond_wait(&pipeline_cond, &pipeline_lock);
+   pthread_mutex_unlock(&pipeline_lock);
+
+   if (pipeline_reinit)
+   {
+      pipeline_reinit = false;
+      Reinitialise();
+   }
+}
+
+// Wait for the frame in progress and throw it away
+static void PipelineDrop()
+{
+   PipelineSync();
+   pipeline_pending = false;
+}
+
+static void PipelineExit()
+{
+   if (!pipeline_started)
+      return;
+
+   PipelineDrop();
+
+   pthread_mutex_lock(&pipeline_lock);
+   pipeline_quit = true;
+   pthread_cond_broadcast(&pipeline_cond);
+   pthread_mutex_unlock(&pipeline_lock);
+
+   pthread_join(pipeline_thread, NULL);
+   pipeline_started = false;
+
+   free(pipeline_frame);
+   pipeline_frame = NULL;
+}
+
+// Stop the worker when threaded frames are turned off. Returns true if it had
+// already emulated a frame, which is then in g_fba_frame and g_audio_buf to be
+// presented instead of emulating another one.
+static bool PipelineFinish()
+{
+   bool pending = pipeline_started && pipeline_pending;
+
+   if (pending)
+   {
+      PipelineSync();
+
+      uint32_t *frame = g_fba_frame;
+      g_fba_frame = pipeline_frame;
+      pipeline_frame = frame;
+   }
+
+   PipelineExit();
+   return pending;
+}
+
+// Present the frame the worker finished and start emulating the next one.
+// Must be called with the machine idle.
+static bool PipelineFrameStep()
+{
+   if (!pipeline_started && !PipelineInit())
+   {
+      log_cb(RETRO_LOG_WARN, "Can't start the frame thread, threaded frames disabled\n");
+      bThreadedFrames = false;
+      return false;
+   }
+
+   if (!pipeline_pending)
+   {
+      InputMake();
+      PipelineStart();
+      PipelineSync();
+   }
+
+   uint32_t *frame = g_fba_frame;
+   g_fba_frame = pipeline_frame;
+   pipeline_frame = frame;
+   memcpy(pipeline_audio_buf, g_audio_buf, nBurnSoundLen * 2 * sizeof(int16_t));
+
+   InputMake();
+   PipelineStart();
+
+   return true;
+}
+#endif
+
 // Non-idiomatic (OutString should be to the left to match strcpy())
 // Seems broken to not check nOutSize.
 char* TCHARToANSI(const TCHAR* pszInString, char* pszOutString, int /*nOutSize*/)
@@ -568,6 +891,10 @@ static int archive_load_rom(uint8_t *dest, int *wrote, int i)
    if (i < 0 || i >= g_rom_count)
       return 1;
 
+   // Already inflated by the prefetch workers?
+   if (prefetch_take(i, dest, wrote) == 0)
+      return 0;
+
    int archive = g_find_list[i].nArchive;
 
    if (ZipOpen((char*)g_find_list_path[archive].c_str()) != 0)
@@ -586,6 +913,16 @@ static int archive_load_rom(uint8_t *dest, int *wrote, int i)
    return 0;
 }
 
+static int archive_rom_file_info(int i, UINT32 *crc, UINT32 *len)
+{
+   if (i < 0 || i >= g_rom_count || !g_find_list[i].nFileLen)
+      return 1;
+
+   *crc = g_find_list[i].nFileCrc;
+   *len = g_find_list[i].nFileLen;
+   return 0;
+}
+
 // This code is very confusing. The original code is even more confusing :(
 static bool open_archive()
 {
@@ -707,6 +1044,8 @@ static bool open_archive()
 			// Yay, we found it!
 			g_find_list[i].nArchive = z;
 			g_find_list[i].nPos = index;
+			g_find_list[i].nFileCrc = list[index].nCrc;
+			g_find_list[i].nFileLen = list[index].nLen;
 			g_find_list[i].nState = STAT_OK;
 
 			if (list[index].nLen < g_find_list[i].ri.nLen)
@@ -756,9 +1095,29 @@ static bool open_archive()
 	}
 
 	BurnExtLoadRom = archive_load_rom;
+	BurnExtRomFileInfo = archive_rom_file_info;
 	return true;
 }
 
+// Let worker threads inflate the ROMs while the driver is busy with the ones it already got
+static void start_rom_prefetch()
+{
+	std::vector<prefetch_rom> roms(g_rom_count);
+
+	for (unsigned i = 0; i < g_rom_count; i++)
+	{
+		// ROMs without a CRC were never looked up in the archives
+		if (g_find_list[i].nState == STAT_NOFIND || g_find_list[i].ri.nType == 0 || g_find_list[i].ri.nLen == 0 || g_find_list[i].ri.nCrc == 0)
+			continue;
+
+		roms[i].archive = g_find_list_path[g_find_list[i].nArchive].c_str();
+		roms[i].entry = g_find_list[i].nPos;
+		roms[i].len = g_find_list[i].ri.nLen;
+	}
+
+	prefetch_start(roms.empty() ? NULL : &roms[0], g_rom_count);
+}
+
 static void SetRotation()
 {
 	unsigned rotation;
@@ -799,6 +1158,11 @@ void retro_deinit()
    {
       snprintf (output, sizeof(output), "%s%c%s.fs", g_save_dir, slash, BurnDrvGetTextA(DRV_NAME));
       BurnStateSave(output, 0);
+#ifdef HAVE_THREADS
+      PipelineExit();
+#endif
+      movie_stop();
+      RunAheadExit();
       BurnDrvExit();
    }
    driver_inited = false;
@@ -809,6 +1173,10 @@ void retro_deinit()
 
 void retro_reset()
 {
+#ifdef HAVE_THREADS
+   PipelineDrop();
+#endif
+
 #if !(defined(CPS1_ONLY) || defined(CPS2_ONLY) || defined(CPS3_ONLY) || defined(GEKKO))
    // restore the NeoSystem because it was changed during the gameplay
    if (is_neogeo_game)
@@ -821,18 +1189,22 @@ void retro_reset()
       *(pgi_reset->Input.pVal) = pgi_reset->Input.nVal;
    }
 
+   // The reset frame doesn't go through InputMake()
+   InputMovieRecord();
+
    ForceFrameStep();
 }
 
 void retro_run()
 {
    int width, height;
-   BurnDrvGetVisibleSize(&width, &height);
-   pBurnDraw = (uint8_t*)g_fba_frame;
+   int16_t *audio_buf = g_audio_buf;
 
-   InputMake();
+#ifdef HAVE_THREADS
+   PipelineSync();
+#endif
 
-   ForceFrameStep();
+   BurnDrvGetVisibleSize(&width, &height);
 
    unsigned drv_flags = BurnDrvGetFlags();
    uint32_t height_tmp = height;
@@ -851,17 +1223,45 @@ void retro_run()
          nBurnPitch = width * pitch_size;
    }
 
+#ifdef HAVE_THREADS
+   if (bThreadedFrames && !nRunAhead && PipelineFrameStep())
+      audio_buf = pipeline_audio_buf;
+   else if (!PipelineFinish())
+#endif
+   {
+      pBurnDraw = (uint8_t*)g_fba_frame;
+
+      InputMake();
+
+      if (nRunAhead)
+         RunAheadFrameStep();
+      else
+         ForceFrameStep();
+   }
+
    video_cb(g_fba_frame, width, height, nBurnPitch);
-   audio_batch_cb(g_audio_buf, nBurnSoundLen);
+   audio_batch_cb(audio_buf, nBurnSoundLen);
+
+#ifdef FBA_PROFILE
+   ProfileUpdate();
+#endif
 
    bool updated = false;
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &updated) && updated)
    {
+#ifdef HAVE_THREADS
+      PipelineSync();
+#endif
+
       neo_geo_modes old_g_opt_neo_geo_mode = g_opt_neo_geo_mode;
+      movie_modes old_g_opt_movie_mode = g_opt_movie_mode;
       bool old_bVerticalMode = bVerticalMode;
 
       check_variables();
 
+      if (old_g_opt_movie_mode != g_opt_movie_mode)
+         MovieStart(false);
+
       apply_dipswitch_from_variables();
 
       // change orientation/geometry if vertical mode was toggled on/off
@@ -881,60 +1281,49 @@ void retro_run()
    }
 }
 
-static uint8_t *write_state_ptr;
-static const uint8_t *read_state_ptr;
-static unsigned state_size;
-
-static int burn_write_state_cb(BurnArea *pba)
-{
-   memcpy(write_state_ptr, pba->Data, pba->nLen);
-   write_state_ptr += pba->nLen;
-   return 0;
-}
-
-static int burn_read_state_cb(BurnArea *pba)
-{
-   memcpy(pba->Data, read_state_ptr, pba->nLen);
-   read_state_ptr += pba->nLen;
-   return 0;
-}
-
-static int burn_dummy_state_cb(BurnArea *pba)
-{
-   state_size += pba->nLen;
-   return 0;
-}
 
 size_t retro_serialize_size()
 {
-   if (state_size)
-      return state_size;
-
-   BurnAcb = burn_dummy_state_cb;
-   state_size = 0;
-   BurnAreaScan(ACB_FULLSCAN | ACB_READ, 0);
-   return state_size;
+#ifdef HAVE_THREADS
+   PipelineSync();
+#endif
+   return BurnAreaLayout(NULL, NULL);
 }
 
 bool retro_serialize(void *data, size_t size)
 {
-   if (size != state_size)
+#ifdef HAVE_THREADS
+   PipelineSync();
+#endif
+
+   if (size != retro_serialize_size())
       return false;
 
-   BurnAcb = burn_write_state_cb;
-   write_state_ptr = (uint8_t*)data;
-   BurnAreaScan(ACB_FULLSCAN | ACB_READ, 0);
+   if (BurnAreaSave((UINT8*)data, size))
+   {
+      log_cb(RETRO_LOG_ERROR, "[FBA] The savestate areas changed size, the state wasn't saved\n");
+      BurnAreaLayoutInvalidate();
+      return false;
+   }
 
    return true;
 }
 
 bool retro_unserialize(const void *data, size_t size)
 {
-   if (size != state_size)
+#ifdef HAVE_THREADS
+   PipelineDrop();
+#endif
+
+   if (!size || size != retro_serialize_size())
+      return false;
+
+   if (BurnAreaLoad((const UINT8*)data, size))
+   {
+      log_cb(RETRO_LOG_ERROR, "[FBA] The savestate areas changed size while loading, the state was only partly loaded\n");
+      BurnAreaLayoutInvalidate();
       return false;
-   BurnAcb = burn_read_state_cb;
-   read_state_ptr = (const uint8_t*)data;
-   BurnAreaScan(ACB_FULLSCAN | ACB_WRITE, 0);
+   }
 
    return true;
 }
@@ -986,12 +1375,18 @@ static bool fba_init(unsigned driver, const char *game_zip_name)
 {
    nBurnDrvActive = driver;
 
+   // Keep the archives open while the driver loads its ROMs
+   ZipCacheInit();
+
    if (!open_archive())
    {
+      ZipCacheExit();
       log_cb(RETRO_LOG_ERROR, "[FBA] Cannot find driver.\n");
       return false;
    }
 
+   start_rom_prefetch();
+
    nBurnBpp = 2;
    nFMInterpolation = 3;
    nInterpolation = 1;
@@ -1002,6 +1397,9 @@ static bool fba_init(unsigned driver, const char *game_zip_name)
 
    BurnDrvInit();
 
+   prefetch_stop();
+   ZipCacheExit();
+
    char input[128];
    snprintf (input, sizeof(input), "%s%c%s.fs", g_save_dir, slash, BurnDrvGetTextA(DRV_NAME));
    BurnStateLoad(input, 0, NULL);
@@ -1152,9 +1550,11 @@ bool retro_load_game(const struct retro_game_info *info)
       log_cb(RETRO_LOG_ERROR, "System dir not defined => use roms dir %s\n", g_system_dir);
    }
 
-   unsigned i = BurnDrvGetIndexByName(basename);
+   unsigned i = BurnDrvFindByName(basename);
    if (i < nBurnDrvCount)
    {
+      nBurnDrvActive = i;
+
       INT32 width, height;
 
       const char * boardrom = BurnDrvGetTextA(DRV_BOARDROM);
@@ -1168,6 +1568,12 @@ bool retro_load_game(const struct retro_game_info *info)
       set_environment();
       check_variables();
 
+      // Decoded graphics cache lives next to the saves
+      if (is_neogeo_game && bNeoGeoGfxCache)
+         snprintf(szAppGfxCachePath, sizeof(szAppGfxCachePath), "%s%c", g_save_dir, slash);
+      else
+         szAppGfxCachePath[0] = 0;
+
       pBurnSoundOut = g_audio_buf;
       nBurnSoundRate = AUDIO_SAMPLERATE;
       nBurnSoundLen = AUDIO_SEGMENT_LENGTH;
@@ -1181,6 +1587,8 @@ bool retro_load_game(const struct retro_game_info *info)
 
       g_fba_frame = (uint32_t*)malloc(width * height * sizeof(uint32_t));
 
+      MovieStart(true);
+
       return true;
    }
 
@@ -1196,6 +1604,13 @@ bool retro_load_game_special(unsigned, const struct retro_game_info*, size_t)
 
 void retro_unload_game(void)
 {
+#ifdef HAVE_THREADS
+   PipelineExit();
+#endif
+#ifdef FBA_PROFILE
+   ProfileDump();
+#endif
+   movie_stop();
    InputDeInit();
 }
 
@@ -1218,20 +1633,3 @@ unsigned retro_api_version(void)
 {
    return RETRO_API_VERSION;
 }
-
-static unsigned int BurnDrvGetIndexByName(const char* name)
-{
-   unsigned int i;
-   unsigned int ret = ~0U;
-
-   for (i = 0; i < nBurnDrvCount; i++)
-   {
-      nBurnDrvActive = i;
-      if (!strcmp(BurnDrvGetText(DRV_NAME), name))
-      {
-         ret = i;
-         break;
-      }
-   }
-   return ret;
-}
@@ -0,0 +1,300 @@
+// Headless benchmark: loads a game through the core like a frontend would, then
+// runs frames as fast as possible and reports the frame rate and frame times.
+// Built with "make -f makefile.libretro bench", it isn't part of the core.
+//
+// With a savestate to go back to, the frames are run three times (with video and
+// sound, without video, and with neither) and the differences give the time spent
+// drawing and making sound, the rest being the cpus and everything else.
+// Profiling builds (make PROFILE=1) also show each pass split by burn_prof.h.
+
+#include <vector>
+#include <algorithm>
+#include <stdarg.h>
+#include <time.h>
+
+#include "retro_common.h"
+#include "retro_input.h"
+#include "retro_movie.h"
+#include "burn_prof.h"
+
+struct bench_pass
+{
+	const char *name;
+	bool video;
+	bool audio;
+	double mean;		// Mean frame time in ms
+};
+
+static const char *dir = NULL;
+static bool verbose = false;
+static uint32_t *frame_buf = NULL;
+static int16_t *audio_buf = NULL;
+
+static void bench_log(enum retro_log_level level, const char *fmt, ...)
+{
+	va_list args;
+
+	if (level < RETRO_LOG_WARN && !verbose)
+		return;
+
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+}
+
+static bool bench_environment(unsigned cmd, void *data)
+{
+	switch (cmd)
+	{
+		case RETRO_ENVIRONMENT_GET_LOG_INTERFACE:
+			((struct retro_log_callback*)data)->log = bench_log;
+			return true;
+		case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+		case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+			// Without one the core uses the ROM's directory
+			*(const char**)data = dir;
+			return dir != NULL;
+		case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+			return true;
+	}
+
+	return false;
+}
+
+static void bench_video(const void*, unsigned, unsigned, size_t) { }
+static size_t bench_audio(const int16_t*, size_t frames) { return frames; }
+static void bench_input_poll() { }
+static int16_t bench_input_state(unsigned, unsigned, unsigned, unsigned) { return 0; }
+
+static double bench_now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// A frame like retro_run() makes one, with video and sound optional
+static void bench_frame(bool video, bool audio)
+{
+	InputMake();
+
+	nBurnLayer = 0xff;
+	pBurnDraw = video ? (UINT8*)frame_buf : NULL;
+	pBurnSoundOut = audio ? audio_buf : NULL;
+	nCurrentFrame++;
+
+	BurnDrvFrame();
+}
+
+static double bench_percentile(const std::vector<double> &sorted, double p)
+{
+	size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+}
+
+#ifdef FBA_PROFILE
+// Where the last frames of a pass went, as timed inside the emulation
+static void bench_profile(const char *out)
+{
+	double mean[BURN_PROF_SECTIONS];
+	int count = BurnProfGetStats(mean, NULL);
+
+	printf("  last %d frames:", count);
+	for (int i = 0; i < BURN_PROF_SECTIONS; i++)
+	{
+		if (mean[i] > 0.0)
+			printf(" %s %.3f", BurnProfSectionName(i), mean[i] / 1000.0);
+	}
+	printf(" ms\n");
+
+	if (out)
+	{
+		size_t len = strlen(out);
+		bool json = len > 5 && !strcmp(out + len - 5, ".json");
+
+		if (BurnProfDump(out, json ? BURN_PROF_JSON : BURN_PROF_CSV))
+			fprintf(stderr, "Can't write %s\n", out);
+	}
+}
+#endif
+
+static void bench_usage()
+{
+	fprintf(stderr,
+		"Usage: fbalpha2012_bench [options] <rom path>\n"
+		"  -f <frames>  frames to time (3000)\n"
+		"  -w <frames>  frames to run first, not timed (600)\n"
+		"  -m <movie>   play an input movie recorded from power-on\n"
+		"  -d <dir>     system and save directory (the ROM's directory)\n"
+		"  -1           one pass only, no draw/sound breakdown\n"
+#ifdef FBA_PROFILE
+		"  -o <file>    write the first pass' profile, as JSON if named .json (CSV)\n"
+#endif
+		"  -v           show the core's log\n");
+}
+
+int main(int argc, char **argv)
+{
+	unsigned frames = 3000;
+	unsigned warmup = 600;
+	const char *movie = NULL;
+	const char *path = NULL;
+#ifdef FBA_PROFILE
+	const char *profile = NULL;
+#endif
+	bool breakdown = true;
+
+	struct bench_pass passes[] = {
+		{ "video+audio", true, true, 0 },
+		{ "audio only", false, true, 0 },
+		{ "no video/audio", false, false, 0 },
+	};
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-f") && i + 1 < argc)
+			frames = strtoul(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "-w") && i + 1 < argc)
+			warmup = strtoul(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "-m") && i + 1 < argc)
+			movie = argv[++i];
+		else if (!strcmp(argv[i], "-d") && i + 1 < argc)
+			dir = argv[++i];
+#ifdef FBA_PROFILE
+		else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+			profile = argv[++i];
+#endif
+		else if (!strcmp(argv[i], "-1"))
+			breakdown = false;
+		else if (!strcmp(argv[i], "-v"))
+			verbose = true;
+		else if (argv[i][0] != '-' && !path)
+			path = argv[i];
+		else
+		{
+			bench_usage();
+			return 1;
+		}
+	}
+
+	if (!path || !frames)
+	{
+		bench_usage();
+		return 1;
+	}
+
+	// The core starts movies named in the environment when the game is loaded
+	if (movie)
+		setenv("FBNEO_MOVIE_PLAY", movie, 1);
+
+	retro_set_environment(bench_environment);
+	retro_set_video_refresh(bench_video);
+	retro_set_audio_sample_batch(bench_audio);
+	retro_set_input_poll(bench_input_poll);
+	retro_set_input_state(bench_input_state);
+	retro_init();
+
+	struct retro_game_info info;
+	memset(&info, 0, sizeof(info));
+	info.path = path;
+
+	double load_start = bench_now();
+	if (!retro_load_game(&info))
+	{
+		fprintf(stderr, "Can't load %s\n", path);
+		retro_deinit();
+		return 1;
+	}
+	double load_time = bench_now() - load_start;
+
+	if (movie && !movie_playing())
+	{
+		fprintf(stderr, "Can't play movie %s\n", movie);
+		retro_unload_game();
+		retro_deinit();
+		return 1;
+	}
+
+	for (unsigned port = 0; port < 5; port++)
+		retro_set_controller_port_device(port, RETROPAD_CLASSIC);
+
+	for (unsigned i = 0; i < warmup; i++)
+		retro_run();
+
+	int width, height;
+	BurnDrvGetFullSize(&width, &height);
+	frame_buf = (uint32_t*)calloc(width * height, sizeof(uint32_t));
+	audio_buf = (int16_t*)calloc(nBurnSoundLen * 2, sizeof(int16_t));
+
+	// Every pass starts from the machine as it is after the warmup
+	struct BurnInstance *start = NULL;
+	if (breakdown)
+	{
+		start = BurnInstanceCreate();
+		if (!start)
+		{
+			fprintf(stderr, "No savestate support, running one pass only\n");
+			breakdown = false;
+		}
+	}
+
+	printf("game: %s (%s)\n", BurnDrvGetTextA(DRV_NAME), BurnDrvGetTextA(DRV_FULLNAME));
+	printf("load: %.1f ms\n", load_time);
+	printf("frames: %u timed after %u%s\n", frames, warmup, movie ? ", with a movie" : "");
+
+	std::vector<double> times(frames);
+	unsigned pass_count = breakdown ? 3 : 1;
+
+	for (unsigned p = 0; p < pass_count; p++)
+	{
+		if (p > 0)
+		{
+			BurnInstanceLoad(start);
+			if (movie && !movie_play_seek(warmup))
+				fprintf(stderr, "The movie has ended, the %s pass runs without it\n", passes[p].name);
+		}
+
+#ifdef FBA_PROFILE
+		BurnProfReset();
+#endif
+
+		double total = 0;
+		for (unsigned i = 0; i < frames; i++)
+		{
+			double start = bench_now();
+			bench_frame(passes[p].video, passes[p].audio);
+			times[i] = bench_now() - start;
+			total += times[i];
+		}
+
+		std::vector<double> sorted(times);
+		std::sort(sorted.begin(), sorted.end());
+		passes[p].mean = total / frames;
+
+		printf("%s: %.1f fps, frame time mean %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f ms\n", passes[p].name, 1000.0 * frames / total,
+			passes[p].mean, bench_percentile(sorted, 0.5), bench_percentile(sorted, 0.9), bench_percentile(sorted, 0.99), sorted.back());
+
+#ifdef FBA_PROFILE
+		bench_profile(p == 0 ? profile : NULL);
+#endif
+	}
+
+	if (breakdown)
+	{
+		double draw = std::max(passes[0].mean - passes[1].mean, 0.0);
+		double sound = std::max(passes[1].mean - passes[2].mean, 0.0);
+		double cpu = passes[2].mean;
+
+		printf("per frame: cpu and the rest %.3f ms, sound %.3f ms, draw %.3f ms\n", cpu, sound, draw);
+	}
+
+	BurnInstanceFree(start);
+
+	retro_unload_game();
+	retro_deinit();
+
+	free(frame_buf);
+	free(audio_buf);
+
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include "retro_common.h"
 #include "retro_input.h"
+#include "burn_idle.h"
 
 struct RomBiosInfo mvs_bioses[] = {
 	{"sp-s3.sp1",         0x91b64be3, 0x00, "MVS Asia/Europe ver. 6 (1 slot)",  1 },
@@ -56,10 +57,14 @@ bool is_neogeo_game = false;
 bool allow_neogeo_mode = true;
 bool bVerticalMode = false;
 bool bAllowDepth32 = false;
+bool bNeoGeoGfxCache = false;
 UINT32 nFrameskip = 1;
+UINT32 nRunAhead = 0;
+bool bThreadedFrames = false;
 INT32 g_audio_samplerate = 48000;
 UINT8 *diag_input;
 neo_geo_modes g_opt_neo_geo_mode = NEO_GEO_MODE_MVS;
+movie_modes g_opt_movie_mode = MOVIE_MODE_DISABLED;
 
 #ifdef USE_CYCLONE
 // 0 - c68k, 1 - m68k
@@ -80,6 +85,12 @@ static const struct retro_variable var_empty = { NULL, NULL };
 static const struct retro_variable var_fbneo_allow_depth_32 = { "fbneo-allow-depth-32", "Use 32-bits color depth when available; disabled|enabled" };
 static const struct retro_variable var_fbneo_vertical_mode = { "fbneo-vertical-mode", "Vertical mode; disabled|enabled" };
 static const struct retro_variable var_fbneo_frameskip = { "fbneo-frameskip", "Frameskip; 0|1|2|3|4|5" };
+static const struct retro_variable var_fbneo_runahead = { "fbneo-runahead", "Run-ahead frames (reduces input lag, needs savestate support); 0|1|2|3|4" };
+#ifdef HAVE_THREADS
+static const struct retro_variable var_fbneo_threaded_frames = { "fbneo-threaded-frames", "Emulate the next frame on another core (adds 1 frame of input lag, off with run-ahead); disabled|enabled" };
+#endif
+static const struct retro_variable var_fbneo_idle_skip = { "fbneo-idle-skip", "Skip CPU idle loops (faster, may change timing); listed|disabled|detected|report" };
+static const struct retro_variable var_fbneo_movie = { "fbneo-movie", "Input movie (<game>.fbm in the save directory, for benchmark and regression runs); disabled|record|play" };
 static const struct retro_variable var_fbneo_cpu_speed_adjust = { "fbneo-cpu-speed-adjust", "CPU overclock; 100|110|120|130|140|150|160|170|180|190|200" };
 static const struct retro_variable var_fbneo_diagnostic_input = { "fbneo-diagnostic-input", "Diagnostic Input; None|Hold Start|Start + A + B|Hold Start + A + B|Start + L + R|Hold Start + L + R|Hold Select|Select + A + B|Hold Select + A + B|Select + L + R|Hold Select + L + R" };
 static const struct retro_variable var_fbneo_hiscores = { "fbneo-hiscores", "Hiscores; enabled|disabled" };
@@ -93,6 +104,7 @@ static const struct retro_variable var_fbneo_cyclone = { "fbneo-cyclone", "Cyclo
 
 // Neo Geo core options
 static const struct retro_variable var_fbneo_neogeo_mode = { "fbneo-neogeo-mode", "Force Neo Geo mode (if available); MVS|AES|UNIBIOS|DIPSWITCH" };
+static const struct retro_variable var_fbneo_neogeo_gfx_cache = { "fbneo-neogeo-gfx-cache", "Cache decoded graphics (faster loading, uses disk space); disabled|enabled" };
 
 // Replace the char c_find by the char c_replace in the destination c string
 char* str_char_replace(char* destination, char c_find, char c_replace)
@@ -229,6 +241,12 @@ void set_environment()
 	vars_systems.push_back(&var_fbneo_allow_depth_32);
 	vars_systems.push_back(&var_fbneo_vertical_mode);
 	vars_systems.push_back(&var_fbneo_frameskip);
+	vars_systems.push_back(&var_fbneo_runahead);
+#ifdef HAVE_THREADS
+	vars_systems.push_back(&var_fbneo_threaded_frames);
+#endif
+	vars_systems.push_back(&var_fbneo_idle_skip);
+	vars_systems.push_back(&var_fbneo_movie);
 	vars_systems.push_back(&var_fbneo_cpu_speed_adjust);
 	vars_systems.push_back(&var_fbneo_hiscores);
 	if (nGameType != RETRO_GAME_TYPE_NEOCD)
@@ -250,6 +268,7 @@ void set_environment()
 		// Add the Neo Geo core options
 		if (allow_neogeo_mode)
 			vars_systems.push_back(&var_fbneo_neogeo_mode);
+		vars_systems.push_back(&var_fbneo_neogeo_gfx_cache);
 	}
 
 	int nbr_vars = vars_systems.size();
@@ -369,6 +388,49 @@ void check_variables(void)
 			nFrameskip = 6;
 	}
 
+	var.key = var_fbneo_runahead.key;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+	{
+		nRunAhead = strtoul(var.value, NULL, 10);
+		if (nRunAhead > 4)
+			nRunAhead = 4;
+	}
+
+#ifdef HAVE_THREADS
+	var.key = var_fbneo_threaded_frames.key;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+	{
+		if (strcmp(var.value, "enabled") == 0)
+			bThreadedFrames = true;
+		else
+			bThreadedFrames = false;
+	}
+#endif
+
+	var.key = var_fbneo_idle_skip.key;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+	{
+		if (strcmp(var.value, "listed") == 0)
+			BurnIdleSetMode(BURN_IDLE_LISTED);
+		else if (strcmp(var.value, "detected") == 0)
+			BurnIdleSetMode(BURN_IDLE_LISTED | BURN_IDLE_DETECT);
+		else if (strcmp(var.value, "report") == 0)
+			BurnIdleSetMode(BURN_IDLE_LISTED | BURN_IDLE_REPORT);
+		else
+			BurnIdleSetMode(0);
+	}
+
+	var.key = var_fbneo_movie.key;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+	{
+		if (strcmp(var.value, "record") == 0)
+			g_opt_movie_mode = MOVIE_MODE_RECORD;
+		else if (strcmp(var.value, "play") == 0)
+			g_opt_movie_mode = MOVIE_MODE_PLAY;
+		else
+			g_opt_movie_mode = MOVIE_MODE_DISABLED;
+	}
+
 	if (pgi_diag)
 	{
 		var.key = var_fbneo_diagnostic_input.key;
@@ -446,6 +508,15 @@ void check_variables(void)
 					g_opt_neo_geo_mode = NEO_GEO_MODE_DIPSWITCH;
 			}
 		}
+
+		var.key = var_fbneo_neogeo_gfx_cache.key;
+		if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+		{
+			if (strcmp(var.value, "enabled") == 0)
+				bNeoGeoGfxCache = true;
+			else
+				bNeoGeoGfxCache = false;
+		}
 	}
 
 	var.key = var_fbneo_hiscores.key;
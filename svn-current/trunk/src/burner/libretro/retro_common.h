@@ -41,6 +41,13 @@ enum neo_geo_modes
 	NEO_GEO_MODE_DIPSWITCH = 3
 };
 
+enum movie_modes
+{
+	MOVIE_MODE_DISABLED = 0,
+	MOVIE_MODE_RECORD = 1,
+	MOVIE_MODE_PLAY = 2
+};
+
 struct RomBiosInfo {
 	char* filename;
 	uint32_t crc;
@@ -66,11 +73,15 @@ extern bool allow_neogeo_mode;
 extern bool core_aspect_par;
 extern bool bVerticalMode;
 extern bool bAllowDepth32;
+extern bool bNeoGeoGfxCache;
 extern UINT32 nFrameskip;
+extern UINT32 nRunAhead;
+extern bool bThreadedFrames;
 extern UINT8 NeoSystem;
 extern INT32 g_audio_samplerate;
 extern UINT8 *diag_input;
 extern neo_geo_modes g_opt_neo_geo_mode;
+extern movie_modes g_opt_movie_mode;
 extern unsigned nGameType;
 extern char g_rom_dir[MAX_PATH];
 
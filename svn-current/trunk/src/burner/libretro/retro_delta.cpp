@@ -0,0 +1,109 @@
+#include "retro_common.h"
+#include "retro_delta.h"
+
+#define DELTA_BLOCK		8	// Bytes compared at a time
+
+static uint8_t *state = NULL;			// Last captured state
+static size_t state_len = 0;
+static bool state_valid = false;
+
+static size_t scan_pos = 0;
+static bool scan_overflow = false;
+
+// Only the blocks which differ from the captured state are written back to it
+static int delta_compare_cb(BurnArea *pba)
+{
+	const uint8_t *cur = (const uint8_t*)pba->Data;
+	uint8_t *old = state + scan_pos;
+	size_t len = pba->nLen;
+
+	if (scan_pos + len > state_len)
+	{
+		scan_overflow = true;
+		return 0;
+	}
+
+	for (size_t i = 0; i < len; i += DELTA_BLOCK)
+	{
+		size_t block = (len - i < DELTA_BLOCK) ? len - i : DELTA_BLOCK;
+
+		if (memcmp(cur + i, old + i, block))
+			memcpy(old + i, cur + i, block);
+	}
+
+	scan_pos += len;
+	return 0;
+}
+
+bool delta_state_init()
+{
+	delta_state_exit();
+
+	state_len = retro_serialize_size();
+	if (!state_len)
+		return false;
+
+	state = (uint8_t*)malloc(state_len);
+	if (!state)
+	{
+		log_cb(RETRO_LOG_ERROR, "Couldn't allocate %u bytes for the delta state\n", (unsigned)state_len);
+		delta_state_exit();
+		return false;
+	}
+
+	return true;
+}
+
+void delta_state_exit()
+{
+	free(state);
+
+	state = NULL;
+	state_len = 0;
+	state_valid = false;
+}
+
+bool delta_state_push()
+{
+	if (!state)
+		return false;
+
+	if (!state_valid)
+	{
+		state_valid = !BurnAreaSave(state, state_len);
+		return state_valid;
+	}
+
+	scan_pos = 0;
+	scan_overflow = false;
+
+	BurnAcb = delta_compare_cb;
+	BurnAreaScan(ACB_FULLSCAN | ACB_READ, 0);
+
+	if (scan_overflow || scan_pos != state_len)
+	{
+		log_cb(RETRO_LOG_WARN, "Savestate size changed, dropping the delta state\n");
+		BurnAreaLayoutInvalidate();
+		state_valid = false;
+		return false;
+	}
+
+	return true;
+}
+
+bool delta_state_restore()
+{
+	if (!state_valid)
+		return false;
+
+	if (BurnAreaLoad(state, state_len))
+	{
+		// Nothing is left to go back to, the caller has to deal with a partly loaded machine
+		log_cb(RETRO_LOG_ERROR, "Savestate size changed, the delta state couldn't be restored\n");
+		BurnAreaLayoutInvalidate();
+		state_valid = false;
+		return false;
+	}
+
+	return true;
+}
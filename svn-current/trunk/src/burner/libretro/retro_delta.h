@@ -0,0 +1,24 @@
+#ifndef __RETRO_DELTA__
+#define __RETRO_DELTA__
+
+#include "burner.h"
+
+// Delta savestate: a snapshot of the running machine which is captured every
+// frame, but after the first capture only the blocks which changed are copied
+// into it.
+
+// Must be called after the driver is initialised, any previous snapshot is dropped
+bool delta_state_init();
+
+// Free the snapshot, this must be done before the driver exits
+void delta_state_exit();
+
+// Capture the current state of the machine. Fails once the savestate size has
+// changed, delta_state_init() has to be called again then.
+bool delta_state_push();
+
+// Put the machine back to the last push. If the savestate size has changed the
+// machine may be left partly loaded, and the snapshot is dropped.
+bool delta_state_restore();
+
+#endif
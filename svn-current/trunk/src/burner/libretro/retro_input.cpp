@@ -3,6 +3,7 @@
 #include "libretro.h"
 #include "burner.h"
 #include "retro_input.h"
+#include "retro_movie.h"
 
 bool bStreetFighterLayout = false;
 bool bLibretroSupportsBitmasks = false;
@@ -2084,7 +2085,7 @@ static void BurnerHandlerKeyCallback()
 	}
 }
 
-void InputMake(void)
+static void InputMakeLive(void)
 {
 	for (int i = 0; i < 5; i++)
 		nLibretroInputBitmask[i] = -1;
@@ -2262,6 +2263,90 @@ void InputMake(void)
 	}
 }
 
+// Input movies log what every input resolved to, not what the frontend reported
+static std::vector<UINT16> movie_values;
+
+void InputMovieRecord(void)
+{
+	struct GameInp* pgi;
+	UINT32 i;
+
+	if (!movie_recording())
+		return;
+
+	movie_values.resize(nGameInpCount);
+
+	for (i = 0, pgi = GameInp; i < nGameInpCount; i++, pgi++) {
+		if (pgi->Input.pVal == NULL) {
+			movie_values[i] = 0;
+		} else if (pgi->nInput == GIT_DIRECT_COORD) {
+			movie_values[i] = (UINT16)pointerValues[pgi->Input.MouseAxis.nMouse][pgi->Input.MouseAxis.nAxis];
+		} else {
+			movie_values[i] = pgi->Input.nVal;
+		}
+	}
+
+	movie_record_frame(&movie_values[0]);
+}
+
+static void InputMoviePlay(const UINT16 *values)
+{
+	struct GameInp* pgi;
+	UINT32 i;
+
+	for (i = 0, pgi = GameInp; i < nGameInpCount; i++, pgi++) {
+		if (pgi->Input.pVal == NULL) {
+			continue;
+		}
+
+		switch (pgi->nInput) {
+			case 0:									// Undefined
+				pgi->Input.nVal = 0;
+				break;
+			case GIT_DIRECT_COORD: {
+				INT32 nPort = pgi->Input.MouseAxis.nMouse;
+				pointerValues[nPort][pgi->Input.MouseAxis.nAxis] = values[i];
+				BurnGunSetCoords(nPort, pointerValues[nPort][0], pointerValues[nPort][1]);
+				break;
+			}
+			case GIT_CONSTANT:						// Constant value (DIP switches come from the movie)
+				pgi->Input.nVal = values[i];
+				*(pgi->Input.pVal) = pgi->Input.nVal;
+				break;
+			default:
+				pgi->Input.nVal = values[i];
+				if (pgi->nInput == GIT_SWITCH && (pgi->nType & BIT_GROUP_ANALOG) == 0) {
+					*(pgi->Input.pVal) = pgi->Input.nVal;
+					break;
+				}
+#ifdef LSB_FIRST
+				*(pgi->Input.pShortVal) = pgi->Input.nVal;
+#else
+				*((int *)pgi->Input.pShortVal) = pgi->Input.nVal;
+#endif
+				break;
+		}
+	}
+}
+
+void InputMake(void)
+{
+	// A movie being played back replaces the live input until it ends
+	if (movie_playing()) {
+		const UINT16 *values;
+
+		poll_cb();
+
+		if ((values = movie_play_frame()) != NULL) {
+			InputMoviePlay(values);
+			return;
+		}
+	}
+
+	InputMakeLive();
+	InputMovieRecord();
+}
+
 void retro_set_controller_port_device(unsigned port, unsigned device)
 {
 	if (port < nMaxPlayers && nDeviceType[port] != device)
@@ -39,6 +39,7 @@ struct AxiBind
 
 void SetDiagInpHoldFrameDelay(unsigned val);
 void InputMake(void);
+void InputMovieRecord(void);		// Log the inputs to a movie being recorded, InputMake() does it itself
 void InputInit();
 void InputDeInit();
 void SetControllerInfo();
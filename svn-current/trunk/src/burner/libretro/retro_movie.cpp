@@ -0,0 +1,260 @@
+#include <vector>
+#include <algorithm>
+
+#include "retro_common.h"
+#include "retro_movie.h"
+
+#define MOVIE_VERSION		1
+#define MOVIE_NAME_LEN		32
+#define MOVIE_HEADER_LEN	(4 + 4 + MOVIE_NAME_LEN + 4 + 4 + 4)
+
+enum movie_mode { MOVIE_OFF, MOVIE_RECORD, MOVIE_PLAY };
+
+static enum movie_mode mode = MOVIE_OFF;
+static FILE *record_file = NULL;
+static std::vector<uint8_t> data;		// Recorded frame, or the whole movie being played
+static size_t play_pos = 0;
+static size_t play_start = 0;			// First frame of the movie being played
+static std::vector<UINT16> values;		// Input values as of the last frame
+static unsigned frame_count = 0;
+
+static void put32(uint8_t *p, uint32_t v)
+{
+	p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put16(std::vector<uint8_t> &out, uint16_t v)
+{
+	out.push_back(v & 0xff);
+	out.push_back(v >> 8);
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+bool movie_record_start(const char *path, unsigned inputs, bool power_on)
+{
+	uint8_t header[MOVIE_HEADER_LEN];
+	std::vector<uint8_t> state;
+
+	movie_stop();
+
+	if (!power_on)
+	{
+		state.resize(retro_serialize_size());
+		if (state.empty() || !retro_serialize(&state[0], state.size()))
+		{
+			log_cb(RETRO_LOG_ERROR, "[FBA] Can't take a savestate to start the movie from\n");
+			return false;
+		}
+	}
+
+	record_file = fopen(path, "wb");
+	if (!record_file)
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] Can't write movie %s\n", path);
+		return false;
+	}
+
+	memset(header, 0, sizeof(header));
+	memcpy(header, "FBMV", 4);
+	put32(header + 4, MOVIE_VERSION);
+	strncpy((char*)header + 8, BurnDrvGetTextA(DRV_NAME), MOVIE_NAME_LEN - 1);
+	put32(header + 8 + MOVIE_NAME_LEN, inputs);
+	put32(header + 12 + MOVIE_NAME_LEN, power_on ? 0 : 1);
+	put32(header + 16 + MOVIE_NAME_LEN, state.size());
+
+	fwrite(header, 1, sizeof(header), record_file);
+	if (!state.empty())
+		fwrite(&state[0], 1, state.size(), record_file);
+
+	// The first frame holds every input (and so the DIP switches), the rest only what changed
+	values.assign(inputs, 0);
+	frame_count = 0;
+	mode = MOVIE_RECORD;
+
+	log_cb(RETRO_LOG_INFO, "[FBA] Recording movie %s from %s\n", path, power_on ? "power-on" : "a savestate");
+	return true;
+}
+
+bool movie_play_start(const char *path, unsigned inputs, bool power_on)
+{
+	movie_stop();
+
+	FILE *fp = fopen(path, "rb");
+	if (!fp)
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] Can't read movie %s\n", path);
+		return false;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	long len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	data.resize(len > 0 ? len : 0);
+	bool read = !data.empty() && fread(&data[0], 1, data.size(), fp) == data.size();
+	fclose(fp);
+
+	if (!read || data.size() < MOVIE_HEADER_LEN || memcmp(&data[0], "FBMV", 4) || get32(&data[4]) != MOVIE_VERSION)
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] %s isn't a movie this core can play\n", path);
+		data.clear();
+		return false;
+	}
+
+	char name[MOVIE_NAME_LEN];
+	memcpy(name, &data[8], MOVIE_NAME_LEN);
+	name[MOVIE_NAME_LEN - 1] = 0;
+
+	uint32_t movie_inputs = get32(&data[8 + MOVIE_NAME_LEN]);
+	uint32_t anchor = get32(&data[12 + MOVIE_NAME_LEN]);
+	uint32_t state_len = get32(&data[16 + MOVIE_NAME_LEN]);
+
+	if (strcmp(name, BurnDrvGetTextA(DRV_NAME)) || movie_inputs != inputs || state_len > data.size() - MOVIE_HEADER_LEN)
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] Movie %s was recorded with %s and %u inputs, not this game\n", path, name, movie_inputs);
+		data.clear();
+		return false;
+	}
+
+	if (anchor)
+	{
+		if (!retro_unserialize(&data[MOVIE_HEADER_LEN], state_len))
+		{
+			log_cb(RETRO_LOG_ERROR, "[FBA] Can't load the savestate movie %s starts from\n", path);
+			data.clear();
+			return false;
+		}
+	}
+	else if (!power_on)
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] Movie %s starts at power-on, load the game with it set to play\n", path);
+		data.clear();
+		return false;
+	}
+
+	play_start = play_pos = MOVIE_HEADER_LEN + state_len;
+	values.assign(inputs, 0);
+	frame_count = 0;
+	mode = MOVIE_PLAY;
+
+	log_cb(RETRO_LOG_INFO, "[FBA] Playing movie %s\n", path);
+	return true;
+}
+
+void movie_stop()
+{
+	if (mode == MOVIE_RECORD)
+	{
+		fclose(record_file);
+		record_file = NULL;
+		log_cb(RETRO_LOG_INFO, "[FBA] Movie recorded, %u frames\n", frame_count);
+	}
+	else if (mode == MOVIE_PLAY)
+	{
+		log_cb(RETRO_LOG_INFO, "[FBA] Movie stopped after %u frames\n", frame_count);
+	}
+
+	mode = MOVIE_OFF;
+	data.clear();
+	values.clear();
+}
+
+bool movie_recording()
+{
+	return mode == MOVIE_RECORD;
+}
+
+bool movie_playing()
+{
+	return mode == MOVIE_PLAY;
+}
+
+void movie_record_frame(const UINT16 *frame)
+{
+	if (mode != MOVIE_RECORD)
+		return;
+
+	uint16_t changed = 0;
+
+	data.resize(2);
+	for (unsigned i = 0; i < values.size(); i++)
+	{
+		if (frame[i] == values[i])
+			continue;
+
+		values[i] = frame[i];
+		put16(data, i);
+		put16(data, frame[i]);
+		changed++;
+	}
+
+	data[0] = changed & 0xff;
+	data[1] = changed >> 8;
+
+	if (fwrite(&data[0], 1, data.size(), record_file) != data.size())
+	{
+		log_cb(RETRO_LOG_ERROR, "[FBA] Can't write the movie, recording stopped\n");
+		movie_stop();
+		return;
+	}
+
+	frame_count++;
+}
+
+const UINT16 *movie_play_frame()
+{
+	if (mode != MOVIE_PLAY)
+		return NULL;
+
+	if (play_pos + 2 > data.size())
+	{
+		movie_stop();
+		return NULL;
+	}
+
+	unsigned changed = get16(&data[play_pos]);
+	if (play_pos + 2 + changed * 4 > data.size())
+	{
+		log_cb(RETRO_LOG_WARN, "[FBA] Movie ends with a partial frame\n");
+		movie_stop();
+		return NULL;
+	}
+
+	play_pos += 2;
+	for (unsigned i = 0; i < changed; i++, play_pos += 4)
+	{
+		unsigned index = get16(&data[play_pos]);
+		if (index < values.size())
+			values[index] = get16(&data[play_pos + 2]);
+	}
+
+	frame_count++;
+	return &values[0];
+}
+
+bool movie_play_seek(unsigned frame)
+{
+	if (mode != MOVIE_PLAY)
+		return false;
+
+	play_pos = play_start;
+	std::fill(values.begin(), values.end(), 0);
+	frame_count = 0;
+
+	while (frame_count < frame)
+	{
+		if (!movie_play_frame())
+			return false;
+	}
+
+	return true;
+}
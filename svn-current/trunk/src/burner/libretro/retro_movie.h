@@ -0,0 +1,41 @@
+#ifndef __RETRO_MOVIE__
+#define __RETRO_MOVIE__
+
+#include "burner.h"
+
+// Input movies: the value every game input resolved to (after mapping, DIP
+// switches included) is logged once a frame, so a session can be played back
+// identically for profiling or regression runs. Movies start either at power-on
+// or from a savestate kept in the file, and only play back on the same build
+// and controller setup they were recorded with.
+//
+// File layout (little endian):
+//   header  "FBMV", version, driver name (32 bytes), input count, anchor
+//           (0 power-on, 1 savestate), savestate size and data
+//   frames  uint16_t count of inputs which changed, then count pairs of
+//           uint16_t input index and value
+
+// Start logging the input values of every frame, returns false if the file can't be written
+bool movie_record_start(const char *path, unsigned inputs, bool power_on);
+
+// Start playing a movie back, power_on tells if the machine hasn't run yet
+// (needed for movies which start there)
+bool movie_play_start(const char *path, unsigned inputs, bool power_on);
+
+// Stop recording or playing, a recording is complete once stopped
+void movie_stop();
+
+bool movie_recording();
+bool movie_playing();
+
+// Log this frame's input values
+void movie_record_frame(const UINT16 *values);
+
+// The input values for this frame, or NULL (and playback stops) at the end of the movie
+const UINT16 *movie_play_frame();
+
+// Carry on playing from the given frame, the machine must be put back to the
+// state it had there. Returns false if the movie is shorter.
+bool movie_play_seek(unsigned frame);
+
+#endif
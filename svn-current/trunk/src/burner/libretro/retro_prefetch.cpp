@@ -0,0 +1,231 @@
+#include "retro_common.h"
+#include "retro_prefetch.h"
+
+#ifdef HAVE_THREADS
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define PREFETCH_MAX_THREADS	4
+#define PREFETCH_MAX_BUFFERED	(64 << 20)	// Inflated bytes allowed to wait for the driver
+
+enum prefetch_state
+{
+	JOB_NONE = 0,	// Not handled by the prefetcher
+	JOB_PENDING,
+	JOB_RUNNING,
+	JOB_DONE,
+	JOB_FAILED,
+	JOB_TAKEN		// Handed over to the driver, or left for it to load itself
+};
+
+struct prefetch_job
+{
+	const char *archive;
+	int entry;
+	int len;
+	int state;
+	uint8_t *data;
+	int wrote;
+};
+
+static struct prefetch_job *jobs = NULL;
+static unsigned job_count = 0;
+static unsigned job_next = 0;
+static size_t buffered_bytes = 0;
+static bool stopping = false;
+
+static pthread_t threads[PREFETCH_MAX_THREADS];
+static unsigned thread_count = 0;
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_finished = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t buffer_freed = PTHREAD_COND_INITIALIZER;
+
+static void *prefetch_worker(void *)
+{
+	void *handle = NULL;
+	const char *handle_archive = NULL;
+
+	pthread_mutex_lock(&job_lock);
+
+	for (;;)
+	{
+		while (!stopping && job_next < job_count && jobs[job_next].state != JOB_PENDING)
+			job_next++;
+
+		if (stopping || job_next >= job_count)
+			break;
+
+		struct prefetch_job *job = &jobs[job_next];
+
+		// Don't run too far ahead of the driver, but always allow one job through
+		if (buffered_bytes && buffered_bytes + job->len > PREFETCH_MAX_BUFFERED)
+		{
+			pthread_cond_wait(&buffer_freed, &job_lock);
+			continue;
+		}
+
+		job->state = JOB_RUNNING;
+		job_next++;
+		buffered_bytes += job->len;
+
+		pthread_mutex_unlock(&job_lock);
+
+		// Jobs come in ROM order, which mostly keeps a worker in the same archive
+		if (handle_archive == NULL || strcmp(handle_archive, job->archive) != 0)
+		{
+			ZipCloseHandle(handle);
+			handle = ZipOpenHandle((char*)job->archive);
+			handle_archive = job->archive;
+		}
+
+		uint8_t *data = NULL;
+		int wrote = 0;
+
+		if (handle)
+		{
+			data = (uint8_t*)malloc(job->len);
+			if (data && ZipLoadFileHandle(handle, data, job->len, &wrote, job->entry) != 0)
+			{
+				free(data);
+				data = NULL;
+			}
+		}
+
+		pthread_mutex_lock(&job_lock);
+
+		if (data == NULL)
+			buffered_bytes -= job->len;
+
+		job->data = data;
+		job->wrote = wrote;
+		job->state = data ? JOB_DONE : JOB_FAILED;
+
+		pthread_cond_broadcast(&job_finished);
+	}
+
+	pthread_mutex_unlock(&job_lock);
+
+	ZipCloseHandle(handle);
+
+	return NULL;
+}
+
+void prefetch_start(const struct prefetch_rom *roms, unsigned count)
+{
+	prefetch_stop();
+
+	// Keep one core for the driver, which consumes the ROMs as they come in
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	unsigned workers = cores > 1 ? (unsigned)(cores - 1) : 0;
+	if (workers > PREFETCH_MAX_THREADS)
+		workers = PREFETCH_MAX_THREADS;
+
+	if (workers == 0 || count == 0)
+		return;
+
+	jobs = (struct prefetch_job*)calloc(count, sizeof(struct prefetch_job));
+	if (jobs == NULL)
+		return;
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		jobs[i].archive = roms[i].archive;
+		jobs[i].entry = roms[i].entry;
+		jobs[i].len = roms[i].len;
+		jobs[i].state = (roms[i].archive && roms[i].len > 0) ? JOB_PENDING : JOB_NONE;
+	}
+
+	job_count = count;
+	job_next = 0;
+	buffered_bytes = 0;
+	stopping = false;
+
+	for (unsigned i = 0; i < workers; i++)
+	{
+		if (pthread_create(&threads[thread_count], NULL, prefetch_worker, NULL) != 0)
+			break;
+		thread_count++;
+	}
+
+	log_cb(RETRO_LOG_INFO, "[FBA] Prefetching ROMs on %u threads.\n", thread_count);
+}
+
+int prefetch_take(unsigned index, uint8_t *dest, int *wrote)
+{
+	if (jobs == NULL || index >= job_count)
+		return -1;
+
+	int ret = -1;
+
+	pthread_mutex_lock(&job_lock);
+
+	struct prefetch_job *job = &jobs[index];
+
+	while (job->state == JOB_RUNNING)
+		pthread_cond_wait(&job_finished, &job_lock);
+
+	if (job->state == JOB_DONE)
+	{
+		memcpy(dest, job->data, job->wrote);
+		if (wrote)
+			*wrote = job->wrote;
+
+		free(job->data);
+		job->data = NULL;
+		buffered_bytes -= job->len;
+		pthread_cond_broadcast(&buffer_freed);
+
+		ret = 0;
+	}
+
+	// Pending jobs are loaded by the caller, failed ones are retried through the normal path
+	if (job->state != JOB_NONE)
+		job->state = JOB_TAKEN;
+
+	pthread_mutex_unlock(&job_lock);
+
+	return ret;
+}
+
+void prefetch_stop()
+{
+	if (jobs == NULL)
+		return;
+
+	pthread_mutex_lock(&job_lock);
+	stopping = true;
+	pthread_cond_broadcast(&buffer_freed);
+	pthread_mutex_unlock(&job_lock);
+
+	for (unsigned i = 0; i < thread_count; i++)
+		pthread_join(threads[i], NULL);
+	thread_count = 0;
+
+	for (unsigned i = 0; i < job_count; i++)
+		free(jobs[i].data);
+
+	free(jobs);
+	jobs = NULL;
+	job_count = 0;
+	job_next = 0;
+	buffered_bytes = 0;
+	stopping = false;
+}
+
+#else
+
+void prefetch_start(const struct prefetch_rom *, unsigned)
+{
+}
+
+int prefetch_take(unsigned, uint8_t *, int *)
+{
+	return -1;
+}
+
+void prefetch_stop()
+{
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef __RETRO_PREFETCH__
+#define __RETRO_PREFETCH__
+
+#include "burner.h"
+
+struct prefetch_rom
+{
+	const char *archive;	// Archive path without extension, NULL if the ROM isn't prefetched
+	int entry;				// Entry index inside the archive
+	int len;				// Number of bytes the driver expects
+};
+
+// Start inflating ROMs on worker threads, roms[i] describes ROM index i.
+// The archive strings must stay valid until prefetch_stop().
+void prefetch_start(const struct prefetch_rom *roms, unsigned count);
+
+// Copy a prefetched ROM to dest, waiting for the workers if it's still being inflated.
+// Returns -1 if the ROM wasn't prefetched, in which case the caller loads it itself.
+int prefetch_take(unsigned index, uint8_t *dest, int *wrote);
+
+// Stop the workers and drop anything the driver didn't ask for
+void prefetch_stop();
+
+#endif
@@ -19,7 +19,57 @@ static INT32 nCurrFile = 0; // The current file we are pointing to
 static _7z_file* _7ZipFile = NULL;
 #endif
 
-INT32 ZipOpen(char* szZip)
+// Archive cache: while active, ZipClose() only detaches from the archive, so that
+// the next ZipOpen() on the same path reuses the handle and the parsed file list
+#define ZIPFN_CACHE_SIZE		32
+
+struct ZipCacheEntry {
+	char* szZip;						// Path as passed to ZipOpen(), NULL if the slot is free
+	INT32 nFileType;					// ZIPFN_FILETYPE_NONE if the archive couldn't be opened
+	unzFile Zip;
+#ifdef INCLUDE_7Z_SUPPORT
+	_7z_file* _7ZipFile;
+#endif
+	INT32 nCurrFile;
+	struct ZipEntry* List;				// Parsed file list, filled by the first ZipGetList()
+	INT32 nListLen;
+	unz_file_pos* FilePos;				// Central directory position of each zip entry
+};
+
+static struct ZipCacheEntry ZipCache[ZIPFN_CACHE_SIZE];
+static struct ZipCacheEntry* pZipCacheCurr = NULL;
+static bool bZipCacheActive = false;
+
+static struct ZipEntry* ZipCopyList(const struct ZipEntry* pSrc, INT32 nListLen)
+{
+	struct ZipEntry* List = (struct ZipEntry *)malloc(nListLen * sizeof(struct ZipEntry));
+	if (List == NULL) return NULL;
+
+	for (INT32 i = 0; i < nListLen; i++) {
+		List[i].szName = NULL;
+		List[i].nLen = pSrc[i].nLen;
+		List[i].nCrc = pSrc[i].nCrc;
+
+		if (pSrc[i].szName) {
+			List[i].szName = (char *)malloc(strlen(pSrc[i].szName) + 1);
+			if (List[i].szName) strcpy(List[i].szName, pSrc[i].szName);
+		}
+	}
+
+	return List;
+}
+
+static void ZipFreeList(struct ZipEntry* List, INT32 nListLen)
+{
+	if (List == NULL) return;
+
+	for (INT32 i = 0; i < nListLen; i++) {
+		if (List[i].szName) free(List[i].szName);
+	}
+	free(List);
+}
+
+static INT32 ZipOpenUncached(char* szZip)
 {
 	nFileType = ZIPFN_FILETYPE_NONE;
 	
@@ -51,8 +101,81 @@ INT32 ZipOpen(char* szZip)
 	return 1;
 }
 
+INT32 ZipOpen(char* szZip)
+{
+	if (!bZipCacheActive) return ZipOpenUncached(szZip);
+
+	nFileType = ZIPFN_FILETYPE_NONE;
+	pZipCacheCurr = NULL;
+
+	if (szZip == NULL) return 1;
+
+	struct ZipCacheEntry* pFree = NULL;
+
+	for (INT32 i = 0; i < ZIPFN_CACHE_SIZE; i++) {
+		struct ZipCacheEntry* pEntry = &ZipCache[i];
+
+		if (pEntry->szZip == NULL) {
+			if (pFree == NULL) pFree = pEntry;
+			continue;
+		}
+
+		if (strcmp(pEntry->szZip, szZip) == 0) {
+			// Archives which failed to open are cached too, so repeated probes stay cheap
+			if (pEntry->nFileType == ZIPFN_FILETYPE_NONE) return 1;
+
+			nFileType = pEntry->nFileType;
+			Zip = pEntry->Zip;
+#ifdef INCLUDE_7Z_SUPPORT
+			_7ZipFile = pEntry->_7ZipFile;
+#endif
+			nCurrFile = pEntry->nCurrFile;
+			pZipCacheCurr = pEntry;
+
+			return 0;
+		}
+	}
+
+	INT32 nRet = ZipOpenUncached(szZip);
+
+	// Cache full, fall back to a plain open
+	if (pFree == NULL) return nRet;
+
+	pFree->szZip = (char *)malloc(strlen(szZip) + 1);
+	if (pFree->szZip == NULL) return nRet;
+	strcpy(pFree->szZip, szZip);
+
+	pFree->nFileType = nFileType;
+	pFree->Zip = Zip;
+#ifdef INCLUDE_7Z_SUPPORT
+	pFree->_7ZipFile = _7ZipFile;
+#endif
+	pFree->nCurrFile = nCurrFile;
+	pFree->List = NULL;
+	pFree->nListLen = 0;
+	pFree->FilePos = NULL;
+
+	if (nRet == 0) pZipCacheCurr = pFree;
+
+	return nRet;
+}
+
 INT32 ZipClose()
 {
+	if (pZipCacheCurr) {
+		// Leave the archive open in the cache, it is closed by ZipCacheExit()
+		pZipCacheCurr->nCurrFile = nCurrFile;
+		pZipCacheCurr = NULL;
+
+		Zip = NULL;
+#ifdef INCLUDE_7Z_SUPPORT
+		_7ZipFile = NULL;
+#endif
+		nFileType = ZIPFN_FILETYPE_NONE;
+
+		return 0;
+	}
+
 	if (nFileType == ZIPFN_FILETYPE_ZIP) {
 		if (Zip != NULL) {
 			unzClose(Zip);
@@ -83,6 +206,16 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 #ifdef INCLUDE_7Z_SUPPORT
 	if (nFileType == ZIPFN_FILETYPE_7ZIP && _7ZipFile == NULL) return 1;	
 #endif
+
+	if (pZipCacheCurr && pZipCacheCurr->List) {
+		struct ZipEntry* List = ZipCopyList(pZipCacheCurr->List, pZipCacheCurr->nListLen);
+		if (List == NULL) return 1;
+
+		*pList = List;
+		if (pnListCount != NULL) *pnListCount = pZipCacheCurr->nListLen;
+
+		return 0;
+	}
 	
 	if (nFileType == ZIPFN_FILETYPE_ZIP) {
 		unz_global_info ZipGlobalInfo;
@@ -93,11 +226,18 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 
 		// Make an array of File Entries
 		struct ZipEntry* List = (struct ZipEntry *)malloc(nListLen * sizeof(struct ZipEntry));
-		if (List == NULL) { unzClose(Zip); return 1; }
+		if (List == NULL) return 1;
 		memset(List, 0, nListLen * sizeof(struct ZipEntry));
 
+		// Remember where each entry lives, so cached loads can seek straight to it
+		unz_file_pos* FilePos = NULL;
+		if (pZipCacheCurr) {
+			FilePos = (unz_file_pos *)malloc(nListLen * sizeof(unz_file_pos));
+			if (FilePos) memset(FilePos, 0, nListLen * sizeof(unz_file_pos));
+		}
+
 		INT32 nRet = unzGoToFirstFile(Zip);
-		if (nRet != UNZ_OK) { unzClose(Zip); return 1; }
+		if (nRet != UNZ_OK) { free(List); if (FilePos) free(FilePos); return 1; }
 
 		// Step through all of the files, until we get to the end
 		INT32 nNextRet = 0;
@@ -122,6 +262,8 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 			List[nCurrFile].szName = szName;
 			List[nCurrFile].nLen = FileInfo.uncompressed_size;
 			List[nCurrFile].nCrc = FileInfo.crc;
+
+			if (FilePos) unzGetFilePos(Zip, &FilePos[nCurrFile]);
 		}
 
 		// return the file list
@@ -130,6 +272,12 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 
 		unzGoToFirstFile(Zip);
 		nCurrFile = 0;
+
+		if (pZipCacheCurr) {
+			pZipCacheCurr->List = ZipCopyList(List, nListLen);
+			pZipCacheCurr->nListLen = pZipCacheCurr->List ? nListLen : 0;
+			pZipCacheCurr->FilePos = FilePos;
+		}
 	}
 	
 #ifdef INCLUDE_7Z_SUPPORT
@@ -188,6 +336,11 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 		nCurrFile = 0;
 		
 		SZipFree(NULL, temp);
+
+		if (pZipCacheCurr) {
+			pZipCacheCurr->List = ZipCopyList(List, nListLen);
+			pZipCacheCurr->nListLen = pZipCacheCurr->List ? nListLen : 0;
+		}
 	}
 #endif
 		
@@ -205,6 +358,14 @@ INT32 ZipLoadFile(UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry)
 	INT32 nRet = 0;
 	
 	if (nFileType == ZIPFN_FILETYPE_ZIP) {
+		if (pZipCacheCurr && pZipCacheCurr->FilePos && nEntry >= 0 && nEntry < pZipCacheCurr->nListLen)
+		{
+			// Jump directly to the entry instead of walking the central directory
+			nRet = unzGoToFilePos(Zip, &pZipCacheCurr->FilePos[nEntry]);
+			if (nRet != UNZ_OK) return 1;
+			nCurrFile = nEntry;
+		}
+
 		if (nEntry < nCurrFile)
 		{
 			// We'll have to go through the zip file again to get to our entry
@@ -255,6 +416,117 @@ INT32 ZipLoadFile(UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry)
 	return 0;
 }
 
+INT32 ZipCacheInit()
+{
+	ZipCacheExit();
+
+	bZipCacheActive = true;
+
+	return 0;
+}
+
+INT32 ZipCacheExit()
+{
+	// Detach from any archive still in use, then close everything for real
+	ZipClose();
+
+	bZipCacheActive = false;
+
+	for (INT32 i = 0; i < ZIPFN_CACHE_SIZE; i++) {
+		struct ZipCacheEntry* pEntry = &ZipCache[i];
+
+		if (pEntry->szZip == NULL) continue;
+
+		if (pEntry->nFileType == ZIPFN_FILETYPE_ZIP && pEntry->Zip != NULL) {
+			unzClose(pEntry->Zip);
+		}
+#ifdef INCLUDE_7Z_SUPPORT
+		if (pEntry->nFileType == ZIPFN_FILETYPE_7ZIP && pEntry->_7ZipFile != NULL) {
+			_7z_file_close(pEntry->_7ZipFile);
+		}
+#endif
+
+		ZipFreeList(pEntry->List, pEntry->nListLen);
+		if (pEntry->FilePos) free(pEntry->FilePos);
+		free(pEntry->szZip);
+
+		memset(pEntry, 0, sizeof(struct ZipCacheEntry));
+	}
+
+	return 0;
+}
+
+// Private zip handles. These don't touch the ZipOpen() state, so several of them
+// can be used at once from different threads. 7z archives aren't supported here.
+struct ZipHandle {
+	unzFile Zip;
+	INT32 nCurrFile;
+};
+
+void* ZipOpenHandle(char* szZip)
+{
+	if (szZip == NULL) return NULL;
+
+	char szFileName[MAX_PATH];
+
+	sprintf(szFileName, "%s.zip", szZip);
+	unzFile HandleZip = unzOpen(szFileName);
+	if (HandleZip == NULL) return NULL;
+
+	struct ZipHandle* pHandle = (struct ZipHandle *)malloc(sizeof(struct ZipHandle));
+	if (pHandle == NULL) {
+		unzClose(HandleZip);
+		return NULL;
+	}
+
+	pHandle->Zip = HandleZip;
+	pHandle->nCurrFile = 0;
+	unzGoToFirstFile(HandleZip);
+
+	return pHandle;
+}
+
+INT32 ZipLoadFileHandle(void* pZipHandle, UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry)
+{
+	struct ZipHandle* pHandle = (struct ZipHandle *)pZipHandle;
+	if (pHandle == NULL) return 1;
+
+	INT32 nRet = 0;
+
+	if (nEntry < pHandle->nCurrFile) {
+		nRet = unzGoToFirstFile(pHandle->Zip);
+		if (nRet != UNZ_OK) return 1;
+		pHandle->nCurrFile = 0;
+	}
+
+	while (pHandle->nCurrFile < nEntry) {
+		nRet = unzGoToNextFile(pHandle->Zip);
+		if (nRet != UNZ_OK) return 1;
+		pHandle->nCurrFile++;
+	}
+
+	nRet = unzOpenCurrentFile(pHandle->Zip);
+	if (nRet != UNZ_OK) return 1;
+
+	nRet = unzReadCurrentFile(pHandle->Zip, Dest, nLen);
+	if (nRet >= 0 && pnWrote != NULL) *pnWrote = nRet;
+
+	nRet = unzCloseCurrentFile(pHandle->Zip);
+	if (nRet == UNZ_CRCERROR) return 2;
+	if (nRet != UNZ_OK) return 1;
+
+	return 0;
+}
+
+void ZipCloseHandle(void* pZipHandle)
+{
+	struct ZipHandle* pHandle = (struct ZipHandle *)pZipHandle;
+	if (pHandle == NULL) return;
+
+	unzClose(pHandle->Zip);
+	free(pHandle);
+}
+
 // Load one file directly, added by regret
 INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, INT32* pnWrote)
 {
@@ -274,7 +546,7 @@ INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, I
 		}
 
 		INT32 nRet = unzGoToFirstFile(Zip);
-		if (nRet != UNZ_OK) { unzClose(Zip); return 1; }
+		if (nRet != UNZ_OK) { ZipClose(); return 1; }
 
 		unz_file_info FileInfo;
 		memset(&FileInfo, 0, sizeof(FileInfo));
@@ -2,10 +2,23 @@
 #include "burnint.h"
 #include "m68000_intf.h"
 #include "m68000_debug.h"
+#include "burn_idle.h"
 
 #ifdef EMU_M68K
 INT32 nSekM68KContextSize[SEK_MAX];
 INT8* SekM68KContext[SEK_MAX];
+
+// The cpu whose registers are in Musashi. Closing a cpu leaves them there, so
+// they're only copied when a different cpu is opened, not on every open/close.
+static INT32 nSekM68KLive = -1;
+
+// Bring SekM68KContext[] up to date with the live registers
+static void SekM68KSaveLive()
+{
+	if (nSekM68KLive >= 0) {
+		m68k_get_context(SekM68KContext[nSekM68KLive]);
+	}
+}
 #endif
 
 INT32 nSekCount = -1;							// Number of allocated 68000s
@@ -632,22 +645,42 @@ void __fastcall A68KChangePC(UINT32 pc)
 
 #ifdef EMU_M68K
 extern "C" {
+// The direct-mapped fetch page last used by the open CPU, so Musashi can read
+// instructions from it without calling out (see M68KFetchCached in m68kconf.h)
+UINT32 nM68KFetchStart = 0;
+UINT32 nM68KFetchLen = 0;
+UINT8* pM68KFetchBase = NULL;
+
 UINT32 __fastcall M68KReadByte(UINT32 a) { return (UINT32)ReadByte(a); }
 UINT32 __fastcall M68KReadWord(UINT32 a) { return (UINT32)ReadWord(a); }
 UINT32 __fastcall M68KReadLong(UINT32 a) { return               ReadLong(a); }
 
+static inline void M68KFetchRemember(UINT32 a)
+{
+	UINT8* pr;
+
+	a &= 0xFFFFFF;
+
+	pr = FIND_F(a);
+	if ((uintptr_t)pr >= SEK_MAXHANDLER) {
+		nM68KFetchStart = a & ~SEK_PAGEM;
+		nM68KFetchLen = SEK_PAGE_SIZE;
+		pM68KFetchBase = pr;
+	}
+}
+
 UINT32 __fastcall M68KFetchByte(UINT32 a) { return (UINT32)FetchByte(a); }
-UINT32 __fastcall M68KFetchWord(UINT32 a) { return (UINT32)FetchWord(a); }
-UINT32 __fastcall M68KFetchLong(UINT32 a) { return               FetchLong(a); }
+UINT32 __fastcall M68KFetchWord(UINT32 a) { M68KFetchRemember(a); return (UINT32)FetchWord(a); }
+UINT32 __fastcall M68KFetchLong(UINT32 a) { M68KFetchRemember(a); return               FetchLong(a); }
 
 #ifdef FBA_DEBUG
 UINT32 __fastcall M68KReadByteBP(UINT32 a) { return (UINT32)ReadByteBP(a); }
 UINT32 __fastcall M68KReadWordBP(UINT32 a) { return (UINT32)ReadWordBP(a); }
 UINT32 __fastcall M68KReadLongBP(UINT32 a) { return               ReadLongBP(a); }
 
-void __fastcall M68KWriteByteBP(UINT32 a, UINT32 d) { WriteByteBP(a, d); }
-void __fastcall M68KWriteWordBP(UINT32 a, UINT32 d) { WriteWordBP(a, d); }
-void __fastcall M68KWriteLongBP(UINT32 a, UINT32 d) { WriteLongBP(a, d); }
+void __fastcall M68KWriteByteBP(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteByteBP(a, d); }
+void __fastcall M68KWriteWordBP(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteWordBP(a, d); }
+void __fastcall M68KWriteLongBP(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteLongBP(a, d); }
 
 void M68KCheckBreakpoint() { CheckBreakpoint_PC(); }
 void M68KSingleStep() { SingleStep_PC(); }
@@ -661,9 +694,9 @@ void (__fastcall *M68KWriteWordDebug)(UINT32, UINT32);
 void (__fastcall *M68KWriteLongDebug)(UINT32, UINT32);
 #endif
 
-void __fastcall M68KWriteByte(UINT32 a, UINT32 d) { WriteByte(a, d); }
-void __fastcall M68KWriteWord(UINT32 a, UINT32 d) { WriteWord(a, d); }
-void __fastcall M68KWriteLong(UINT32 a, UINT32 d) { WriteLong(a, d); }
+void __fastcall M68KWriteByte(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteByte(a, d); }
+void __fastcall M68KWriteWord(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteWord(a, d); }
+void __fastcall M68KWriteLong(UINT32 a, UINT32 d) { BURN_IDLE_WRITE(); WriteLong(a, d); }
 }
 #endif
 
@@ -818,6 +851,11 @@ extern "C" void M68KcmpildCallback(UINT32 val, INT32 reg)
 		pSekExt->CmpCallback(val, reg);
 	}
 }
+
+extern "C" INT32 M68KIdleCheck(UINT32 nHead, UINT32 nBranch, UINT32* pRegs)
+{
+	return BurnIdleCheck(BURN_IDLE_CPU_M68K | nSekActive, nHead & 0xFFFFFF, nBranch & 0xFFFFFF, pRegs, 16 * sizeof(UINT32));
+}
 #endif
 
 // ----------------------------------------------------------------------------
@@ -852,6 +890,10 @@ static INT32 SekInitCPUA68K(INT32 nCount, INT32 nCPUType)
 #ifdef EMU_M68K
 static INT32 SekInitCPUM68K(INT32 nCount, INT32 nCPUType)
 {
+	// Setting the cpu type changes the live registers
+	SekM68KSaveLive();
+	nSekM68KLive = -1;
+
 	nSekCPUType[nCount] = nCPUType;
 
 	switch (nCPUType) {
@@ -1119,6 +1161,9 @@ INT32 SekExit()
 
 	nSekActive = -1;
 	nSekCount = -1;
+#ifdef EMU_M68K
+	nSekM68KLive = -1;
+#endif
 	
 	DebugCPU_SekInitted = 0;
 
@@ -1155,6 +1200,14 @@ void SekReset()
 // ----------------------------------------------------------------------------
 // Control the active CPU
 
+// Forget the page Musashi fetches from, needed whenever the memory map or the open CPU changes
+static inline void SekFetchInvalidate()
+{
+#ifdef EMU_M68K
+	nM68KFetchLen = 0;
+#endif
+}
+
 // Open a CPU
 void SekOpen(const INT32 i)
 {
@@ -1168,6 +1221,7 @@ void SekOpen(const INT32 i)
 		nSekActive = i;
 
 		pSekExt = SekExt[nSekActive];						// Point to cpu context
+		SekFetchInvalidate();
 
 #ifdef EMU_A68K
 		if (nSekCPUType[nSekActive] == 0) {
@@ -1177,7 +1231,11 @@ void SekOpen(const INT32 i)
 #endif
 
 #ifdef EMU_M68K
-			m68k_set_context(SekM68KContext[nSekActive]);
+			if (nSekM68KLive != nSekActive) {
+				SekM68KSaveLive();
+				m68k_set_context(SekM68KContext[nSekActive]);
+				nSekM68KLive = nSekActive;
+			}
 #endif
 
 #ifdef EMU_A68K
@@ -1199,20 +1257,15 @@ void SekClose()
 #ifdef EMU_A68K
 	if (nSekCPUType[nSekActive] == 0) {
 		memcpy(SekRegs[nSekActive], &M68000_regs, sizeof(M68000_regs));
-	} else {
-#endif
-
-#ifdef EMU_M68K
-		m68k_get_context(SekM68KContext[nSekActive]);
-#endif
-
-#ifdef EMU_A68K
 	}
 #endif
 
+	// Musashi's registers stay live until another cpu is opened (see SekOpen)
+
 	nSekCycles[nSekActive] = nSekCyclesTotal;
 	
 	nSekActive = -1;
+	SekFetchInvalidate();
 }
 
 // Get the current CPU
@@ -1344,6 +1397,8 @@ INT32 SekRun(const INT32 nCycles)
 	if (nSekActive == -1) bprintf(PRINT_ERROR, _T("SekRun called when no CPU open\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_M68K);
+
 #ifdef EMU_A68K
 	if (nSekCPUType[nSekActive] == 0) {
 		nSekCyclesDone = 0;
@@ -1558,6 +1613,8 @@ INT32 SekMapMemory(UINT8* pMemory, UINT32 nStart, UINT32 nEnd, INT32 nType)
 	UINT8* Ptr = pMemory - nStart;
 	UINT8** pMemMap = pSekExt->MemMap + (nStart >> SEK_SHIFT);
 
+	SekFetchInvalidate();
+
 	// Special case for ROM banks
 	if (nType == SM_ROM) {
 		for (UINT32 i = (nStart & ~SEK_PAGEM); i <= nEnd; i += SEK_PAGE_SIZE, pMemMap++) {
@@ -1593,6 +1650,8 @@ INT32 SekMapHandler(uintptr_t nHandler, UINT32 nStart, UINT32 nEnd, INT32 nType)
 
 	UINT8** pMemMap = pSekExt->MemMap + (nStart >> SEK_SHIFT);
 
+	SekFetchInvalidate();
+
 	// Add to memory map
 	for (UINT32 i = (nStart & ~SEK_PAGEM); i <= nEnd; i += SEK_PAGE_SIZE, pMemMap++) {
 
@@ -2040,6 +2099,13 @@ INT32 SekScan(INT32 nAction)
 
 	nSekActive = -1;
 
+#ifdef EMU_M68K
+	SekM68KSaveLive();
+	if (nAction & ACB_WRITE) {
+		nSekM68KLive = -1;								// Load the new registers on the next open
+	}
+#endif
+
 	for (INT32 i = 0; i <= nSekCount; i++) {
 		char szName[] = "MC68000 #n";
 #if defined EMU_A68K && defined EMU_M68K
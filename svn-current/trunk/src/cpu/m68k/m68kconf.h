@@ -196,6 +196,15 @@ unsigned int __fastcall M68KFetchByte(unsigned int a);
 unsigned int __fastcall M68KFetchWord(unsigned int a);
 unsigned int __fastcall M68KFetchLong(unsigned int a);
 
+extern unsigned int nM68KFetchStart;
+extern unsigned int nM68KFetchLen;
+extern unsigned char* pM68KFetchBase;
+
+/* Idle loop detection (see burn_idle.h), checked on short backward branches */
+#define M68K_IDLE_LOOP_MAX 0x20
+extern int nBurnIdleActive;
+int M68KIdleCheck(unsigned int head, unsigned int branch, unsigned int* regs);
+
 extern unsigned int (*SekDbgFetchByteDisassembler)(unsigned int);
 extern unsigned int (*SekDbgFetchWordDisassembler)(unsigned int);
 extern unsigned int (*SekDbgFetchLongDisassembler)(unsigned int);
@@ -229,9 +238,35 @@ void __fastcall M68KWriteLong(unsigned int a, unsigned int d);
 #define m68k_read_pcrelative_16(address) M68KFetchWord(address)
 #define m68k_read_pcrelative_32(address) M68KFetchLong(address)
 
-/* Read data immediately following the PC */
+/* Read data immediately following the PC. Straight-line code stays in one
+ * page, so it's read directly from the page the last fetch was served from
+ * (memory is stored as native-endian words, hence the swap for 32 bits).
+ */
+#ifndef MSB_FIRST
+INLINE unsigned int M68KFetchCachedWord(unsigned int a)
+{
+	unsigned int o = (a & 0xffffff) - nM68KFetchStart;
+	if (o < nM68KFetchLen)
+		return *(unsigned short*)(pM68KFetchBase + o);
+	return M68KFetchWord(a);
+}
+
+INLINE unsigned int M68KFetchCachedLong(unsigned int a)
+{
+	unsigned int o = (a & 0xffffff) - nM68KFetchStart;
+	if (o < nM68KFetchLen) {
+		unsigned int r = *(unsigned int*)(pM68KFetchBase + o);
+		return (r >> 16) | (r << 16);
+	}
+	return M68KFetchLong(a);
+}
+
+#define m68k_read_immediate_16(address) M68KFetchCachedWord(address)
+#define m68k_read_immediate_32(address) M68KFetchCachedLong(address)
+#else
 #define m68k_read_immediate_16(address) M68KFetchWord(address)
 #define m68k_read_immediate_32(address) M68KFetchLong(address)
+#endif
 
 /* Memory access for the disassembler */
 #define m68k_read_disassembler_8(address) SekDbgFetchByteDisassembler(address)
@@ -1380,14 +1380,23 @@ static INLINE void m68ki_jump_vector(uint vector)
  * So far I've found no problems with not calling pc_changed for 8 or 16
  * bit branches.
  */
+static INLINE void m68ki_idle_check(void)
+{
+	if(nBurnIdleActive && REG_PPC - REG_PC <= M68K_IDLE_LOOP_MAX)
+		if(M68KIdleCheck(REG_PC, REG_PPC, REG_DA))
+			USE_ALL_CYCLES();
+}
+
 static INLINE void m68ki_branch_8(uint offset)
 {
 	REG_PC += MAKE_INT_8(offset);
+	m68ki_idle_check();
 }
 
 static INLINE void m68ki_branch_16(uint offset)
 {
 	REG_PC += MAKE_INT_16(offset);
+	m68ki_idle_check();
 }
 
 static INLINE void m68ki_branch_32(uint offset)
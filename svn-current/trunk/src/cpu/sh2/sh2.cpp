@@ -38,6 +38,7 @@
 #include <retro_inline.h>
 
 #include "burnint.h"
+#include "burn_idle.h"
 #include "sh2_intf.h"
 
 int has_sh2;
@@ -475,6 +476,10 @@ static cpu_core_config Sh2CheatCpuConfig =
 	0
 };
 
+#if !USE_JUMPTABLE
+static void sh2_decode_init();
+#endif
+
 int Sh2Init(int nCount)
 {
 	DebugCPU_SH2Initted = 1;
@@ -488,6 +493,10 @@ int Sh2Init(int nCount)
 	}
 	memset(Sh2Ext, 0, sizeof(SH2EXT) * nCount);
 
+#if !USE_JUMPTABLE
+	sh2_decode_init();
+#endif
+
 	// init default memory handler
 	for (int i=0; i<nCount; i++) {
 		pSh2Ext = Sh2Ext + i;
@@ -694,6 +703,7 @@ static INLINE void WB(UINT32 A, UINT8 V)
 	program_write_byte_32be(A & AM,V); */
 	
 	unsigned char* pr;
+	BURN_IDLE_WRITE();
 	pr = pSh2Ext->MemMap[(A >> SH2_SHIFT) + SH2_WADD];
 	if ((uintptr_t)pr >= SH2_MAXHANDLER) {
 #ifndef MSB_FIRST
@@ -713,6 +723,7 @@ static INLINE void WW(UINT32 A, UINT16 V)
 	program_write_word_32be(A & AM,V); */
 
 	unsigned char * pr;
+	BURN_IDLE_WRITE();
 	pr = pSh2Ext->MemMap[(A >> SH2_SHIFT) + SH2_WADD];
 	if ((uintptr_t)pr >= SH2_MAXHANDLER) {
 #ifndef MSB_FIRST
@@ -731,6 +742,7 @@ static INLINE void WL(UINT32 A, UINT32 V)
 	if (A >= 0x40000000) return;
 	program_write_dword_32be(A & AM,V); */
 	unsigned char * pr;
+	BURN_IDLE_WRITE();
 	pr = pSh2Ext->MemMap[(A >> SH2_SHIFT) + SH2_WADD];
 	if ((uintptr_t)pr >= SH2_MAXHANDLER) {
 		*((unsigned int *)(pr + (A & SH2_PAGEM))) = (unsigned int)V;
@@ -739,6 +751,20 @@ static INLINE void WL(UINT32 A, UINT32 V)
 	pSh2Ext->WriteLong[(uintptr_t)pr](A, V);
 }
 
+/* Burn the timeslice if the branch at address branch went back into an
+ * idle loop (see burn_idle.h) */
+static INLINE void sh2_idle_check(UINT32 branch)
+{
+	if (nBurnIdleActive && branch - sh2->pc <= BURN_IDLE_LOOP_MAX)
+	{
+		if (sh2->sh2_icount > 0 && BurnIdleCheck(BURN_IDLE_CPU_SH2 | (pSh2Ext - Sh2Ext), sh2->pc, branch, sh2->r, sizeof(sh2->r)))
+		{
+			sh2->sh2_total_cycles += sh2->sh2_icount;
+			sh2->sh2_icount = 0;
+		}
+	}
+}
+
 static INLINE void sh2_exception(/*const char *message,*/ int irqline)
 {
 	int vector;
@@ -926,6 +952,7 @@ static INLINE void BF(UINT32 d)
 		sh2->pc = sh2->ea = sh2->pc + disp * 2 + 2;
 		change_pc(sh2->pc & AM);
 		sh2->sh2_icount -= 2;
+		sh2_idle_check(sh2->ppc - 2);
 	}
 }
 
@@ -941,6 +968,7 @@ static INLINE void BFS(UINT32 d)
 		sh2->delay = sh2->pc;
 		sh2->pc = sh2->ea = sh2->pc + disp * 2 + 2;
 		sh2->sh2_icount--;
+		sh2_idle_check(sh2->ppc - 2);
 	}
 }
 
@@ -972,6 +1000,7 @@ static INLINE void BRA(UINT32 d)
 	sh2->delay = sh2->pc;
 	sh2->pc = sh2->ea = sh2->pc + disp * 2 + 2;
 	sh2->sh2_icount--;
+	sh2_idle_check(sh2->ppc - 2);
 }
 
 /*  code                 cycles  t-bit
@@ -1023,6 +1052,7 @@ static INLINE void BT(UINT32 d)
 		sh2->pc = sh2->ea = sh2->pc + disp * 2 + 2;
 		change_pc(sh2->pc & AM);
 		sh2->sh2_icount -= 2;
+		sh2_idle_check(sh2->ppc - 2);
 	}
 }
 
@@ -1038,6 +1068,7 @@ static INLINE void BTS(UINT32 d)
 		sh2->delay = sh2->pc;
 		sh2->pc = sh2->ea = sh2->pc + disp * 2 + 2;
 		sh2->sh2_icount--;
+		sh2_idle_check(sh2->ppc - 2);
 	}
 }
 
@@ -2419,317 +2450,596 @@ static INLINE void XTRCT(UINT32 m, UINT32 n)
  *  OPCODE DISPATCHERS
  *****************************************************************************/
 
-static INLINE void op0000(UINT16 opcode)
+// Every opcode is decoded once, at init, to the number of the instruction it
+// runs, so executing it takes a single switch (see sh2_execute())
+enum {
+	SH2_OP_NOP,
+	SH2_OP_STCSR,
+	SH2_OP_BSRF,
+	SH2_OP_MOVBS0,
+	SH2_OP_MOVWS0,
+	SH2_OP_MOVLS0,
+	SH2_OP_MULL,
+	SH2_OP_CLRT,
+	SH2_OP_STSMACH,
+	SH2_OP_RTS,
+	SH2_OP_MOVBL0,
+	SH2_OP_MOVWL0,
+	SH2_OP_MOVLL0,
+	SH2_OP_MAC_L,
+	SH2_OP_STCGBR,
+	SH2_OP_SETT,
+	SH2_OP_DIV0U,
+	SH2_OP_STSMACL,
+	SH2_OP_SLEEP,
+	SH2_OP_STCVBR,
+	SH2_OP_BRAF,
+	SH2_OP_CLRMAC,
+	SH2_OP_MOVT,
+	SH2_OP_STSPR,
+	SH2_OP_RTE,
+	SH2_OP_MOVLS4,
+	SH2_OP_MOVBS,
+	SH2_OP_MOVWS,
+	SH2_OP_MOVLS,
+	SH2_OP_MOVBM,
+	SH2_OP_MOVWM,
+	SH2_OP_MOVLM,
+	SH2_OP_DIV0S,
+	SH2_OP_TST,
+	SH2_OP_AND,
+	SH2_OP_XOR,
+	SH2_OP_OR,
+	SH2_OP_CMPSTR,
+	SH2_OP_XTRCT,
+	SH2_OP_MULU,
+	SH2_OP_MULS,
+	SH2_OP_CMPEQ,
+	SH2_OP_CMPHS,
+	SH2_OP_CMPGE,
+	SH2_OP_DIV1,
+	SH2_OP_DMULU,
+	SH2_OP_CMPHI,
+	SH2_OP_CMPGT,
+	SH2_OP_SUB,
+	SH2_OP_SUBC,
+	SH2_OP_SUBV,
+	SH2_OP_ADD,
+	SH2_OP_DMULS,
+	SH2_OP_ADDC,
+	SH2_OP_ADDV,
+	SH2_OP_SHLL,
+	SH2_OP_SHLR,
+	SH2_OP_STSMMACH,
+	SH2_OP_STCMSR,
+	SH2_OP_ROTL,
+	SH2_OP_ROTR,
+	SH2_OP_LDSMMACH,
+	SH2_OP_LDCMSR,
+	SH2_OP_SHLL2,
+	SH2_OP_SHLR2,
+	SH2_OP_LDSMACH,
+	SH2_OP_JSR,
+	SH2_OP_LDCSR,
+	SH2_OP_MAC_W,
+	SH2_OP_DT,
+	SH2_OP_CMPPZ,
+	SH2_OP_STSMMACL,
+	SH2_OP_STCMGBR,
+	SH2_OP_CMPPL,
+	SH2_OP_LDSMMACL,
+	SH2_OP_LDCMGBR,
+	SH2_OP_SHLL8,
+	SH2_OP_SHLR8,
+	SH2_OP_LDSMACL,
+	SH2_OP_TAS,
+	SH2_OP_LDCGBR,
+	SH2_OP_SHAL,
+	SH2_OP_SHAR,
+	SH2_OP_STSMPR,
+	SH2_OP_STCMVBR,
+	SH2_OP_ROTCL,
+	SH2_OP_ROTCR,
+	SH2_OP_LDSMPR,
+	SH2_OP_LDCMVBR,
+	SH2_OP_SHLL16,
+	SH2_OP_SHLR16,
+	SH2_OP_LDSPR,
+	SH2_OP_JMP,
+	SH2_OP_LDCVBR,
+	SH2_OP_MOVLL4,
+	SH2_OP_MOVBL,
+	SH2_OP_MOVWL,
+	SH2_OP_MOVLL,
+	SH2_OP_MOV,
+	SH2_OP_MOVBP,
+	SH2_OP_MOVWP,
+	SH2_OP_MOVLP,
+	SH2_OP_NOT,
+	SH2_OP_SWAPB,
+	SH2_OP_SWAPW,
+	SH2_OP_NEGC,
+	SH2_OP_NEG,
+	SH2_OP_EXTUB,
+	SH2_OP_EXTUW,
+	SH2_OP_EXTSB,
+	SH2_OP_EXTSW,
+	SH2_OP_ADDI,
+	SH2_OP_MOVBS4,
+	SH2_OP_MOVWS4,
+	SH2_OP_MOVBL4,
+	SH2_OP_MOVWL4,
+	SH2_OP_CMPIM,
+	SH2_OP_BT,
+	SH2_OP_BF,
+	SH2_OP_BTS,
+	SH2_OP_BFS,
+	SH2_OP_MOVWI,
+	SH2_OP_BRA,
+	SH2_OP_BSR,
+	SH2_OP_MOVBSG,
+	SH2_OP_MOVWSG,
+	SH2_OP_MOVLSG,
+	SH2_OP_TRAPA,
+	SH2_OP_MOVBLG,
+	SH2_OP_MOVWLG,
+	SH2_OP_MOVLLG,
+	SH2_OP_MOVA,
+	SH2_OP_TSTI,
+	SH2_OP_ANDI,
+	SH2_OP_XORI,
+	SH2_OP_ORI,
+	SH2_OP_TSTM,
+	SH2_OP_ANDM,
+	SH2_OP_XORM,
+	SH2_OP_ORM,
+	SH2_OP_MOVLI,
+	SH2_OP_MOVI,
+
+	SH2_OP_COUNT
+};
+
+static UINT8 sh2_decoded[0x10000];
+
+static UINT8 sh2_decode(UINT16 opcode)
 {
-	switch (opcode & 0x3F)
+	switch (opcode >> 12)
 	{
-	case 0x00:
-	case 0x01: NOP();						break;
-	case 0x02: STCSR(Rn);					break;
-	case 0x03: BSRF(Rn);					break;
-	case 0x04: MOVBS0(Rm, Rn);				break;
-	case 0x05: MOVWS0(Rm, Rn);				break;
-	case 0x06: MOVLS0(Rm, Rn);				break;
-	case 0x07: MULL(Rm, Rn);				break;
-	case 0x08: CLRT();						break;
-	case 0x09: NOP();						break;
-	case 0x0a: STSMACH(Rn); 				break;
-	case 0x0b: RTS();						break;
-	case 0x0c: MOVBL0(Rm, Rn);				break;
-	case 0x0d: MOVWL0(Rm, Rn);				break;
-	case 0x0e: MOVLL0(Rm, Rn);				break;
-	case 0x0f: MAC_L(Rm, Rn);				break;
-
-	case 0x10: 
-	case 0x11: NOP();						break;
-	case 0x12: STCGBR(Rn);					break;
-	case 0x13: NOP();						break;
-	case 0x14: MOVBS0(Rm, Rn);				break;
-	case 0x15: MOVWS0(Rm, Rn);				break;
-	case 0x16: MOVLS0(Rm, Rn);				break;
-	case 0x17: MULL(Rm, Rn);				break;
-	case 0x18: SETT();						break;
-	case 0x19: DIV0U(); 					break;
-	case 0x1a: STSMACL(Rn); 				break;
-	case 0x1b: SLEEP(); 					break;
-	case 0x1c: MOVBL0(Rm, Rn);				break;
-	case 0x1d: MOVWL0(Rm, Rn);				break;
-	case 0x1e: MOVLL0(Rm, Rn);				break;
-	case 0x1f: MAC_L(Rm, Rn);				break;
-
-	case 0x20:
-	case 0x21: NOP();						break;
-	case 0x22: STCVBR(Rn);					break;
-	case 0x23: BRAF(Rn);					break;
-	case 0x24: MOVBS0(Rm, Rn);				break;
-	case 0x25: MOVWS0(Rm, Rn);				break;
-	case 0x26: MOVLS0(Rm, Rn);				break;
-	case 0x27: MULL(Rm, Rn);				break;
-	case 0x28: CLRMAC();					break;
-	case 0x29: MOVT(Rn);					break;
-	case 0x2a: STSPR(Rn);					break;
-	case 0x2b: RTE();						break;
-	case 0x2c: MOVBL0(Rm, Rn);				break;
-	case 0x2d: MOVWL0(Rm, Rn);				break;
-	case 0x2e: MOVLL0(Rm, Rn);				break;
-	case 0x2f: MAC_L(Rm, Rn);				break;
-
-	case 0x30: 
-	case 0x31: 
-	case 0x32:
-	case 0x33: NOP();						break;
-	case 0x34: MOVBS0(Rm, Rn);				break;
-	case 0x35: MOVWS0(Rm, Rn);				break;
-	case 0x36: MOVLS0(Rm, Rn);				break;
-	case 0x37: MULL(Rm, Rn);				break;
-	case 0x38:
-	case 0x39:
-	case 0x3a:
-	case 0x3b: NOP();						break;
-	case 0x3c: MOVBL0(Rm, Rn);				break;
-	case 0x3d: MOVWL0(Rm, Rn);				break;
-	case 0x3e: MOVLL0(Rm, Rn);				break;
-	case 0x3f: MAC_L(Rm, Rn);				break;
-
+	case  0:
+		switch (opcode & 0x3F)
+		{
+		case 0x00:
+		case 0x01: return SH2_OP_NOP;
+		case 0x02: return SH2_OP_STCSR;
+		case 0x03: return SH2_OP_BSRF;
+		case 0x04: return SH2_OP_MOVBS0;
+		case 0x05: return SH2_OP_MOVWS0;
+		case 0x06: return SH2_OP_MOVLS0;
+		case 0x07: return SH2_OP_MULL;
+		case 0x08: return SH2_OP_CLRT;
+		case 0x09: return SH2_OP_NOP;
+		case 0x0a: return SH2_OP_STSMACH;
+		case 0x0b: return SH2_OP_RTS;
+		case 0x0c: return SH2_OP_MOVBL0;
+		case 0x0d: return SH2_OP_MOVWL0;
+		case 0x0e: return SH2_OP_MOVLL0;
+		case 0x0f: return SH2_OP_MAC_L;
+		case 0x10:
+		case 0x11: return SH2_OP_NOP;
+		case 0x12: return SH2_OP_STCGBR;
+		case 0x13: return SH2_OP_NOP;
+		case 0x14: return SH2_OP_MOVBS0;
+		case 0x15: return SH2_OP_MOVWS0;
+		case 0x16: return SH2_OP_MOVLS0;
+		case 0x17: return SH2_OP_MULL;
+		case 0x18: return SH2_OP_SETT;
+		case 0x19: return SH2_OP_DIV0U;
+		case 0x1a: return SH2_OP_STSMACL;
+		case 0x1b: return SH2_OP_SLEEP;
+		case 0x1c: return SH2_OP_MOVBL0;
+		case 0x1d: return SH2_OP_MOVWL0;
+		case 0x1e: return SH2_OP_MOVLL0;
+		case 0x1f: return SH2_OP_MAC_L;
+		case 0x20:
+		case 0x21: return SH2_OP_NOP;
+		case 0x22: return SH2_OP_STCVBR;
+		case 0x23: return SH2_OP_BRAF;
+		case 0x24: return SH2_OP_MOVBS0;
+		case 0x25: return SH2_OP_MOVWS0;
+		case 0x26: return SH2_OP_MOVLS0;
+		case 0x27: return SH2_OP_MULL;
+		case 0x28: return SH2_OP_CLRMAC;
+		case 0x29: return SH2_OP_MOVT;
+		case 0x2a: return SH2_OP_STSPR;
+		case 0x2b: return SH2_OP_RTE;
+		case 0x2c: return SH2_OP_MOVBL0;
+		case 0x2d: return SH2_OP_MOVWL0;
+		case 0x2e: return SH2_OP_MOVLL0;
+		case 0x2f: return SH2_OP_MAC_L;
+		case 0x30:
+		case 0x31:
+		case 0x32:
+		case 0x33: return SH2_OP_NOP;
+		case 0x34: return SH2_OP_MOVBS0;
+		case 0x35: return SH2_OP_MOVWS0;
+		case 0x36: return SH2_OP_MOVLS0;
+		case 0x37: return SH2_OP_MULL;
+		case 0x38:
+		case 0x39:
+		case 0x3a:
+		case 0x3b: return SH2_OP_NOP;
+		case 0x3c: return SH2_OP_MOVBL0;
+		case 0x3d: return SH2_OP_MOVWL0;
+		case 0x3e: return SH2_OP_MOVLL0;
+		case 0x3f: return SH2_OP_MAC_L;
+		}
+		break;
 
+	case  1:
+		return SH2_OP_MOVLS4;
 
-	}
-}
+	case  2:
+		switch (opcode & 15)
+		{
+		case 0: return SH2_OP_MOVBS;
+		case 1: return SH2_OP_MOVWS;
+		case 2: return SH2_OP_MOVLS;
+		case 3: return SH2_OP_NOP;
+		case 4: return SH2_OP_MOVBM;
+		case 5: return SH2_OP_MOVWM;
+		case 6: return SH2_OP_MOVLM;
+		case 7: return SH2_OP_DIV0S;
+		case 8: return SH2_OP_TST;
+		case 9: return SH2_OP_AND;
+		case 10: return SH2_OP_XOR;
+		case 11: return SH2_OP_OR;
+		case 12: return SH2_OP_CMPSTR;
+		case 13: return SH2_OP_XTRCT;
+		case 14: return SH2_OP_MULU;
+		case 15: return SH2_OP_MULS;
+		}
+		break;
 
-static INLINE void op0001(UINT16 opcode)
-{
-	MOVLS4(Rm, opcode & 0x0f, Rn);
-}
+	case  3:
+		switch (opcode & 15)
+		{
+		case 0: return SH2_OP_CMPEQ;
+		case 1: return SH2_OP_NOP;
+		case 2: return SH2_OP_CMPHS;
+		case 3: return SH2_OP_CMPGE;
+		case 4: return SH2_OP_DIV1;
+		case 5: return SH2_OP_DMULU;
+		case 6: return SH2_OP_CMPHI;
+		case 7: return SH2_OP_CMPGT;
+		case 8: return SH2_OP_SUB;
+		case 9: return SH2_OP_NOP;
+		case 10: return SH2_OP_SUBC;
+		case 11: return SH2_OP_SUBV;
+		case 12: return SH2_OP_ADD;
+		case 13: return SH2_OP_DMULS;
+		case 14: return SH2_OP_ADDC;
+		case 15: return SH2_OP_ADDV;
+		}
+		break;
 
-static INLINE void op0010(UINT16 opcode)
-{
-	switch (opcode & 15)
-	{
-	case  0: MOVBS(Rm, Rn); 				break;
-	case  1: MOVWS(Rm, Rn); 				break;
-	case  2: MOVLS(Rm, Rn); 				break;
-	case  3: NOP(); 						break;
-	case  4: MOVBM(Rm, Rn); 				break;
-	case  5: MOVWM(Rm, Rn); 				break;
-	case  6: MOVLM(Rm, Rn); 				break;
-	case  7: DIV0S(Rm, Rn); 				break;
-	case  8: TST(Rm, Rn);					break;
-	case  9: AND(Rm, Rn);					break;
-	case 10: XOR(Rm, Rn);					break;
-	case 11: OR(Rm, Rn);					break;
-	case 12: CMPSTR(Rm, Rn);				break;
-	case 13: XTRCT(Rm, Rn); 				break;
-	case 14: MULU(Rm, Rn);					break;
-	case 15: MULS(Rm, Rn);					break;
-	}
-}
+	case  4:
+		switch (opcode & 0x3F)
+		{
+		case 0x00: return SH2_OP_SHLL;
+		case 0x01: return SH2_OP_SHLR;
+		case 0x02: return SH2_OP_STSMMACH;
+		case 0x03: return SH2_OP_STCMSR;
+		case 0x04: return SH2_OP_ROTL;
+		case 0x05: return SH2_OP_ROTR;
+		case 0x06: return SH2_OP_LDSMMACH;
+		case 0x07: return SH2_OP_LDCMSR;
+		case 0x08: return SH2_OP_SHLL2;
+		case 0x09: return SH2_OP_SHLR2;
+		case 0x0a: return SH2_OP_LDSMACH;
+		case 0x0b: return SH2_OP_JSR;
+		case 0x0c:
+		case 0x0d: return SH2_OP_NOP;
+		case 0x0e: return SH2_OP_LDCSR;
+		case 0x0f: return SH2_OP_MAC_W;
+		case 0x10: return SH2_OP_DT;
+		case 0x11: return SH2_OP_CMPPZ;
+		case 0x12: return SH2_OP_STSMMACL;
+		case 0x13: return SH2_OP_STCMGBR;
+		case 0x14: return SH2_OP_NOP;
+		case 0x15: return SH2_OP_CMPPL;
+		case 0x16: return SH2_OP_LDSMMACL;
+		case 0x17: return SH2_OP_LDCMGBR;
+		case 0x18: return SH2_OP_SHLL8;
+		case 0x19: return SH2_OP_SHLR8;
+		case 0x1a: return SH2_OP_LDSMACL;
+		case 0x1b: return SH2_OP_TAS;
+		case 0x1c:
+		case 0x1d: return SH2_OP_NOP;
+		case 0x1e: return SH2_OP_LDCGBR;
+		case 0x1f: return SH2_OP_MAC_W;
+		case 0x20: return SH2_OP_SHAL;
+		case 0x21: return SH2_OP_SHAR;
+		case 0x22: return SH2_OP_STSMPR;
+		case 0x23: return SH2_OP_STCMVBR;
+		case 0x24: return SH2_OP_ROTCL;
+		case 0x25: return SH2_OP_ROTCR;
+		case 0x26: return SH2_OP_LDSMPR;
+		case 0x27: return SH2_OP_LDCMVBR;
+		case 0x28: return SH2_OP_SHLL16;
+		case 0x29: return SH2_OP_SHLR16;
+		case 0x2a: return SH2_OP_LDSPR;
+		case 0x2b: return SH2_OP_JMP;
+		case 0x2c:
+		case 0x2d: return SH2_OP_NOP;
+		case 0x2e: return SH2_OP_LDCVBR;
+		case 0x2f: return SH2_OP_MAC_W;
+		case 0x30:
+		case 0x31:
+		case 0x32:
+		case 0x33:
+		case 0x34:
+		case 0x35:
+		case 0x36:
+		case 0x37:
+		case 0x38:
+		case 0x39:
+		case 0x3a:
+		case 0x3b:
+		case 0x3c:
+		case 0x3d:
+		case 0x3e: return SH2_OP_NOP;
+		case 0x3f: return SH2_OP_MAC_W;
+		}
+		break;
 
-static INLINE void op0011(UINT16 opcode)
-{
-	switch (opcode & 15)
-	{
-	case  0: CMPEQ(Rm, Rn); 				break;
-	case  1: NOP(); 						break;
-	case  2: CMPHS(Rm, Rn); 				break;
-	case  3: CMPGE(Rm, Rn); 				break;
-	case  4: DIV1(Rm, Rn);					break;
-	case  5: DMULU(Rm, Rn); 				break;
-	case  6: CMPHI(Rm, Rn); 				break;
-	case  7: CMPGT(Rm, Rn); 				break;
-	case  8: SUB(Rm, Rn);					break;
-	case  9: NOP(); 						break;
-	case 10: SUBC(Rm, Rn);					break;
-	case 11: SUBV(Rm, Rn);					break;
-	case 12: ADD(Rm, Rn);					break;
-	case 13: DMULS(Rm, Rn); 				break;
-	case 14: ADDC(Rm, Rn);					break;
-	case 15: ADDV(Rm, Rn);					break;
-	}
-}
+	case  5:
+		return SH2_OP_MOVLL4;
 
-static INLINE void op0100(UINT16 opcode)
-{
-	switch (opcode & 0x3F)
-	{
-	case 0x00: SHLL(Rn);					break;
-	case 0x01: SHLR(Rn);					break;
-	case 0x02: STSMMACH(Rn);				break;
-	case 0x03: STCMSR(Rn);					break;
-	case 0x04: ROTL(Rn);					break;
-	case 0x05: ROTR(Rn);					break;
-	case 0x06: LDSMMACH(Rn);				break;
-	case 0x07: LDCMSR(Rn);					break;
-	case 0x08: SHLL2(Rn);					break;
-	case 0x09: SHLR2(Rn);					break;
-	case 0x0a: LDSMACH(Rn); 				break;
-	case 0x0b: JSR(Rn); 					break;
-	case 0x0c:
-	case 0x0d: NOP();						break;
-	case 0x0e: LDCSR(Rn);					break;
-	case 0x0f: MAC_W(Rm, Rn);				break;
-
-	case 0x10: DT(Rn);						break;
-	case 0x11: CMPPZ(Rn);					break;
-	case 0x12: STSMMACL(Rn);				break;
-	case 0x13: STCMGBR(Rn); 				break;
-	case 0x14: NOP();						break;
-	case 0x15: CMPPL(Rn);					break;
-	case 0x16: LDSMMACL(Rn);				break;
-	case 0x17: LDCMGBR(Rn); 				break;
-	case 0x18: SHLL8(Rn);					break;
-	case 0x19: SHLR8(Rn);					break;
-	case 0x1a: LDSMACL(Rn); 				break;
-	case 0x1b: TAS(Rn); 					break;
-	case 0x1c:
-	case 0x1d: NOP();						break;
-	case 0x1e: LDCGBR(Rn);					break;
-	case 0x1f: MAC_W(Rm, Rn);				break;
-
-	case 0x20: SHAL(Rn);					break;
-	case 0x21: SHAR(Rn);					break;
-	case 0x22: STSMPR(Rn);					break;
-	case 0x23: STCMVBR(Rn); 				break;
-	case 0x24: ROTCL(Rn);					break;
-	case 0x25: ROTCR(Rn);					break;
-	case 0x26: LDSMPR(Rn);					break;
-	case 0x27: LDCMVBR(Rn); 				break;
-	case 0x28: SHLL16(Rn);					break;
-	case 0x29: SHLR16(Rn);					break;
-	case 0x2a: LDSPR(Rn);					break;
-	case 0x2b: JMP(Rn); 					break;
-	case 0x2c:
-	case 0x2d: NOP();						break;
-	case 0x2e: LDCVBR(Rn);					break;
-	case 0x2f: MAC_W(Rm, Rn);				break;
-
-	case 0x30:
-	case 0x31:
-	case 0x32: 
-	case 0x33:
-	case 0x34:
-	case 0x35:
-	case 0x36:
-	case 0x37:
-	case 0x38:
-	case 0x39:
-	case 0x3a:
-	case 0x3b:
-	case 0x3c:
-	case 0x3d:
-	case 0x3e: NOP();						break;
-	case 0x3f: MAC_W(Rm, Rn);				break;
-
-	}
-}
+	case  6:
+		switch (opcode & 15)
+		{
+		case 0: return SH2_OP_MOVBL;
+		case 1: return SH2_OP_MOVWL;
+		case 2: return SH2_OP_MOVLL;
+		case 3: return SH2_OP_MOV;
+		case 4: return SH2_OP_MOVBP;
+		case 5: return SH2_OP_MOVWP;
+		case 6: return SH2_OP_MOVLP;
+		case 7: return SH2_OP_NOT;
+		case 8: return SH2_OP_SWAPB;
+		case 9: return SH2_OP_SWAPW;
+		case 10: return SH2_OP_NEGC;
+		case 11: return SH2_OP_NEG;
+		case 12: return SH2_OP_EXTUB;
+		case 13: return SH2_OP_EXTUW;
+		case 14: return SH2_OP_EXTSB;
+		case 15: return SH2_OP_EXTSW;
+		}
+		break;
 
-static INLINE void op0101(UINT16 opcode)
-{
-	MOVLL4(Rm, opcode & 0x0f, Rn);
-}
+	case  7:
+		return SH2_OP_ADDI;
 
-static INLINE void op0110(UINT16 opcode)
-{
-	switch (opcode & 15)
-	{
-	case  0: MOVBL(Rm, Rn); 				break;
-	case  1: MOVWL(Rm, Rn); 				break;
-	case  2: MOVLL(Rm, Rn); 				break;
-	case  3: MOV(Rm, Rn);					break;
-	case  4: MOVBP(Rm, Rn); 				break;
-	case  5: MOVWP(Rm, Rn); 				break;
-	case  6: MOVLP(Rm, Rn); 				break;
-	case  7: NOT(Rm, Rn);					break;
-	case  8: SWAPB(Rm, Rn); 				break;
-	case  9: SWAPW(Rm, Rn); 				break;
-	case 10: NEGC(Rm, Rn);					break;
-	case 11: NEG(Rm, Rn);					break;
-	case 12: EXTUB(Rm, Rn); 				break;
-	case 13: EXTUW(Rm, Rn); 				break;
-	case 14: EXTSB(Rm, Rn); 				break;
-	case 15: EXTSW(Rm, Rn); 				break;
-	}
-}
+	case  8:
+		switch (opcode  & (15<<8))
+		{
+		case 0 << 8: return SH2_OP_MOVBS4;
+		case 1 << 8: return SH2_OP_MOVWS4;
+		case 2<< 8:
+		case 3<< 8: return SH2_OP_NOP;
+		case 4<< 8: return SH2_OP_MOVBL4;
+		case 5<< 8: return SH2_OP_MOVWL4;
+		case 6<< 8:
+		case 7<< 8: return SH2_OP_NOP;
+		case 8<< 8: return SH2_OP_CMPIM;
+		case 9<< 8: return SH2_OP_BT;
+		case 10<< 8: return SH2_OP_NOP;
+		case 11<< 8: return SH2_OP_BF;
+		case 12<< 8: return SH2_OP_NOP;
+		case 13<< 8: return SH2_OP_BTS;
+		case 14<< 8: return SH2_OP_NOP;
+		case 15<< 8: return SH2_OP_BFS;
+		}
+		break;
 
-static INLINE void op0111(UINT16 opcode)
-{
-	ADDI(opcode & 0xff, Rn);
-}
+	case  9:
+		return SH2_OP_MOVWI;
 
-static INLINE void op1000(UINT16 opcode)
-{
-	switch ( opcode  & (15<<8) )
-	{
-	case  0 << 8: MOVBS4(opcode & 0x0f, Rm); 	break;
-	case  1 << 8: MOVWS4(opcode & 0x0f, Rm); 	break;
-	case  2<< 8:
-	case  3<< 8: NOP(); 				break;
-	case  4<< 8: MOVBL4(Rm, opcode & 0x0f); 	break;
-	case  5<< 8: MOVWL4(Rm, opcode & 0x0f); 	break;
-	case  6<< 8:
-	case  7<< 8: NOP(); 				break;
-	case  8<< 8: CMPIM(opcode & 0xff);		break;
-	case  9<< 8: BT(opcode & 0xff); 		break;
-	case 10<< 8: NOP(); 				break;
-	case 11<< 8: BF(opcode & 0xff); 		break;
-	case 12<< 8: NOP(); 				break;
-	case 13<< 8: BTS(opcode & 0xff);		break;
-	case 14<< 8: NOP(); 				break;
-	case 15<< 8: BFS(opcode & 0xff);		break;
-	}
-}
+	case 10:
+		return SH2_OP_BRA;
 
+	case 11:
+		return SH2_OP_BSR;
 
-static INLINE void op1001(UINT16 opcode)
-{
-	MOVWI(opcode & 0xff, Rn);
-}
+	case 12:
+		switch (opcode & (15<<8))
+		{
+		case 0<<8: return SH2_OP_MOVBSG;
+		case 1<<8: return SH2_OP_MOVWSG;
+		case 2<<8: return SH2_OP_MOVLSG;
+		case 3<<8: return SH2_OP_TRAPA;
+		case 4<<8: return SH2_OP_MOVBLG;
+		case 5<<8: return SH2_OP_MOVWLG;
+		case 6<<8: return SH2_OP_MOVLLG;
+		case 7<<8: return SH2_OP_MOVA;
+		case 8<<8: return SH2_OP_TSTI;
+		case 9<<8: return SH2_OP_ANDI;
+		case 10<<8: return SH2_OP_XORI;
+		case 11<<8: return SH2_OP_ORI;
+		case 12<<8: return SH2_OP_TSTM;
+		case 13<<8: return SH2_OP_ANDM;
+		case 14<<8: return SH2_OP_XORM;
+		case 15<<8: return SH2_OP_ORM;
+		}
+		break;
 
-static INLINE void op1010(UINT16 opcode)
-{
-	BRA(opcode & 0xfff);
-}
+	case 13:
+		return SH2_OP_MOVLI;
 
-static INLINE void op1011(UINT16 opcode)
-{
-	BSR(opcode & 0xfff);
-}
+	case 14:
+		return SH2_OP_MOVI;
 
-static INLINE void op1100(UINT16 opcode)
-{
-	switch (opcode & (15<<8))
-	{
-	case  0<<8: MOVBSG(opcode & 0xff); 		break;
-	case  1<<8: MOVWSG(opcode & 0xff); 		break;
-	case  2<<8: MOVLSG(opcode & 0xff); 		break;
-	case  3<<8: TRAPA(opcode & 0xff);		break;
-	case  4<<8: MOVBLG(opcode & 0xff); 		break;
-	case  5<<8: MOVWLG(opcode & 0xff); 		break;
-	case  6<<8: MOVLLG(opcode & 0xff); 		break;
-	case  7<<8: MOVA(opcode & 0xff);		break;
-	case  8<<8: TSTI(opcode & 0xff);		break;
-	case  9<<8: ANDI(opcode & 0xff);		break;
-	case 10<<8: XORI(opcode & 0xff);		break;
-	case 11<<8: ORI(opcode & 0xff);			break;
-	case 12<<8: TSTM(opcode & 0xff);		break;
-	case 13<<8: ANDM(opcode & 0xff);		break;
-	case 14<<8: XORM(opcode & 0xff);		break;
-	case 15<<8: ORM(opcode & 0xff);			break;
+	case 15:
+		return SH2_OP_NOP;
 	}
-}
 
-static INLINE void op1101(UINT16 opcode)
-{
-	MOVLI(opcode & 0xff, Rn);
+	return SH2_OP_NOP;
 }
 
-static INLINE void op1110(UINT16 opcode)
+static void sh2_decode_init()
 {
-	MOVI(opcode & 0xff, Rn);
+	for (int i = 0; i < 0x10000; i++) {
+		sh2_decoded[i] = sh2_decode(i);
+	}
 }
 
-static INLINE void op1111(UINT16 /*opcode*/)
+static INLINE void sh2_execute(UINT16 opcode)
 {
-	NOP();
+	switch (sh2_decoded[opcode])
+	{
+	case SH2_OP_NOP:	NOP();										break;
+	case SH2_OP_STCSR:	STCSR(Rn);									break;
+	case SH2_OP_BSRF:	BSRF(Rn);									break;
+	case SH2_OP_MOVBS0:	MOVBS0(Rm, Rn);								break;
+	case SH2_OP_MOVWS0:	MOVWS0(Rm, Rn);								break;
+	case SH2_OP_MOVLS0:	MOVLS0(Rm, Rn);								break;
+	case SH2_OP_MULL:	MULL(Rm, Rn);								break;
+	case SH2_OP_CLRT:	CLRT();										break;
+	case SH2_OP_STSMACH:	STSMACH(Rn);								break;
+	case SH2_OP_RTS:	RTS();										break;
+	case SH2_OP_MOVBL0:	MOVBL0(Rm, Rn);								break;
+	case SH2_OP_MOVWL0:	MOVWL0(Rm, Rn);								break;
+	case SH2_OP_MOVLL0:	MOVLL0(Rm, Rn);								break;
+	case SH2_OP_MAC_L:	MAC_L(Rm, Rn);								break;
+	case SH2_OP_STCGBR:	STCGBR(Rn);									break;
+	case SH2_OP_SETT:	SETT();										break;
+	case SH2_OP_DIV0U:	DIV0U();									break;
+	case SH2_OP_STSMACL:	STSMACL(Rn);								break;
+	case SH2_OP_SLEEP:	SLEEP();									break;
+	case SH2_OP_STCVBR:	STCVBR(Rn);									break;
+	case SH2_OP_BRAF:	BRAF(Rn);									break;
+	case SH2_OP_CLRMAC:	CLRMAC();									break;
+	case SH2_OP_MOVT:	MOVT(Rn);									break;
+	case SH2_OP_STSPR:	STSPR(Rn);									break;
+	case SH2_OP_RTE:	RTE();										break;
+	case SH2_OP_MOVLS4:	MOVLS4(Rm, opcode & 0x0f, Rn);				break;
+	case SH2_OP_MOVBS:	MOVBS(Rm, Rn);								break;
+	case SH2_OP_MOVWS:	MOVWS(Rm, Rn);								break;
+	case SH2_OP_MOVLS:	MOVLS(Rm, Rn);								break;
+	case SH2_OP_MOVBM:	MOVBM(Rm, Rn);								break;
+	case SH2_OP_MOVWM:	MOVWM(Rm, Rn);								break;
+	case SH2_OP_MOVLM:	MOVLM(Rm, Rn);								break;
+	case SH2_OP_DIV0S:	DIV0S(Rm, Rn);								break;
+	case SH2_OP_TST:	TST(Rm, Rn);								break;
+	case SH2_OP_AND:	AND(Rm, Rn);								break;
+	case SH2_OP_XOR:	XOR(Rm, Rn);								break;
+	case SH2_OP_OR:		OR(Rm, Rn);									break;
+	case SH2_OP_CMPSTR:	CMPSTR(Rm, Rn);								break;
+	case SH2_OP_XTRCT:	XTRCT(Rm, Rn);								break;
+	case SH2_OP_MULU:	MULU(Rm, Rn);								break;
+	case SH2_OP_MULS:	MULS(Rm, Rn);								break;
+	case SH2_OP_CMPEQ:	CMPEQ(Rm, Rn);								break;
+	case SH2_OP_CMPHS:	CMPHS(Rm, Rn);								break;
+	case SH2_OP_CMPGE:	CMPGE(Rm, Rn);								break;
+	case SH2_OP_DIV1:	DIV1(Rm, Rn);								break;
+	case SH2_OP_DMULU:	DMULU(Rm, Rn);								break;
+	case SH2_OP_CMPHI:	CMPHI(Rm, Rn);								break;
+	case SH2_OP_CMPGT:	CMPGT(Rm, Rn);								break;
+	case SH2_OP_SUB:	SUB(Rm, Rn);								break;
+	case SH2_OP_SUBC:	SUBC(Rm, Rn);								break;
+	case SH2_OP_SUBV:	SUBV(Rm, Rn);								break;
+	case SH2_OP_ADD:	ADD(Rm, Rn);								break;
+	case SH2_OP_DMULS:	DMULS(Rm, Rn);								break;
+	case SH2_OP_ADDC:	ADDC(Rm, Rn);								break;
+	case SH2_OP_ADDV:	ADDV(Rm, Rn);								break;
+	case SH2_OP_SHLL:	SHLL(Rn);									break;
+	case SH2_OP_SHLR:	SHLR(Rn);									break;
+	case SH2_OP_STSMMACH:	STSMMACH(Rn);								break;
+	case SH2_OP_STCMSR:	STCMSR(Rn);									break;
+	case SH2_OP_ROTL:	ROTL(Rn);									break;
+	case SH2_OP_ROTR:	ROTR(Rn);									break;
+	case SH2_OP_LDSMMACH:	LDSMMACH(Rn);								break;
+	case SH2_OP_LDCMSR:	LDCMSR(Rn);									break;
+	case SH2_OP_SHLL2:	SHLL2(Rn);									break;
+	case SH2_OP_SHLR2:	SHLR2(Rn);									break;
+	case SH2_OP_LDSMACH:	LDSMACH(Rn);								break;
+	case SH2_OP_JSR:	JSR(Rn);									break;
+	case SH2_OP_LDCSR:	LDCSR(Rn);									break;
+	case SH2_OP_MAC_W:	MAC_W(Rm, Rn);								break;
+	case SH2_OP_DT:		DT(Rn);										break;
+	case SH2_OP_CMPPZ:	CMPPZ(Rn);									break;
+	case SH2_OP_STSMMACL:	STSMMACL(Rn);								break;
+	case SH2_OP_STCMGBR:	STCMGBR(Rn);								break;
+	case SH2_OP_CMPPL:	CMPPL(Rn);									break;
+	case SH2_OP_LDSMMACL:	LDSMMACL(Rn);								break;
+	case SH2_OP_LDCMGBR:	LDCMGBR(Rn);								break;
+	case SH2_OP_SHLL8:	SHLL8(Rn);									break;
+	case SH2_OP_SHLR8:	SHLR8(Rn);									break;
+	case SH2_OP_LDSMACL:	LDSMACL(Rn);								break;
+	case SH2_OP_TAS:	TAS(Rn);									break;
+	case SH2_OP_LDCGBR:	LDCGBR(Rn);									break;
+	case SH2_OP_SHAL:	SHAL(Rn);									break;
+	case SH2_OP_SHAR:	SHAR(Rn);									break;
+	case SH2_OP_STSMPR:	STSMPR(Rn);									break;
+	case SH2_OP_STCMVBR:	STCMVBR(Rn);								break;
+	case SH2_OP_ROTCL:	ROTCL(Rn);									break;
+	case SH2_OP_ROTCR:	ROTCR(Rn);									break;
+	case SH2_OP_LDSMPR:	LDSMPR(Rn);									break;
+	case SH2_OP_LDCMVBR:	LDCMVBR(Rn);								break;
+	case SH2_OP_SHLL16:	SHLL16(Rn);									break;
+	case SH2_OP_SHLR16:	SHLR16(Rn);									break;
+	case SH2_OP_LDSPR:	LDSPR(Rn);									break;
+	case SH2_OP_JMP:	JMP(Rn);									break;
+	case SH2_OP_LDCVBR:	LDCVBR(Rn);									break;
+	case SH2_OP_MOVLL4:	MOVLL4(Rm, opcode & 0x0f, Rn);				break;
+	case SH2_OP_MOVBL:	MOVBL(Rm, Rn);								break;
+	case SH2_OP_MOVWL:	MOVWL(Rm, Rn);								break;
+	case SH2_OP_MOVLL:	MOVLL(Rm, Rn);								break;
+	case SH2_OP_MOV:	MOV(Rm, Rn);								break;
+	case SH2_OP_MOVBP:	MOVBP(Rm, Rn);								break;
+	case SH2_OP_MOVWP:	MOVWP(Rm, Rn);								break;
+	case SH2_OP_MOVLP:	MOVLP(Rm, Rn);								break;
+	case SH2_OP_NOT:	NOT(Rm, Rn);								break;
+	case SH2_OP_SWAPB:	SWAPB(Rm, Rn);								break;
+	case SH2_OP_SWAPW:	SWAPW(Rm, Rn);								break;
+	case SH2_OP_NEGC:	NEGC(Rm, Rn);								break;
+	case SH2_OP_NEG:	NEG(Rm, Rn);								break;
+	case SH2_OP_EXTUB:	EXTUB(Rm, Rn);								break;
+	case SH2_OP_EXTUW:	EXTUW(Rm, Rn);								break;
+	case SH2_OP_EXTSB:	EXTSB(Rm, Rn);								break;
+	case SH2_OP_EXTSW:	EXTSW(Rm, Rn);								break;
+	case SH2_OP_ADDI:	ADDI(opcode & 0xff, Rn);					break;
+	case SH2_OP_MOVBS4:	MOVBS4(opcode & 0x0f, Rm);					break;
+	case SH2_OP_MOVWS4:	MOVWS4(opcode & 0x0f, Rm);					break;
+	case SH2_OP_MOVBL4:	MOVBL4(Rm, opcode & 0x0f);					break;
+	case SH2_OP_MOVWL4:	MOVWL4(Rm, opcode & 0x0f);					break;
+	case SH2_OP_CMPIM:	CMPIM(opcode & 0xff);						break;
+	case SH2_OP_BT:		BT(opcode & 0xff);							break;
+	case SH2_OP_BF:		BF(opcode & 0xff);							break;
+	case SH2_OP_BTS:	BTS(opcode & 0xff);							break;
+	case SH2_OP_BFS:	BFS(opcode & 0xff);							break;
+	case SH2_OP_MOVWI:	MOVWI(opcode & 0xff, Rn);					break;
+	case SH2_OP_BRA:	BRA(opcode & 0xfff);						break;
+	case SH2_OP_BSR:	BSR(opcode & 0xfff);						break;
+	case SH2_OP_MOVBSG:	MOVBSG(opcode & 0xff);						break;
+	case SH2_OP_MOVWSG:	MOVWSG(opcode & 0xff);						break;
+	case SH2_OP_MOVLSG:	MOVLSG(opcode & 0xff);						break;
+	case SH2_OP_TRAPA:	TRAPA(opcode & 0xff);						break;
+	case SH2_OP_MOVBLG:	MOVBLG(opcode & 0xff);						break;
+	case SH2_OP_MOVWLG:	MOVWLG(opcode & 0xff);						break;
+	case SH2_OP_MOVLLG:	MOVLLG(opcode & 0xff);						break;
+	case SH2_OP_MOVA:	MOVA(opcode & 0xff);						break;
+	case SH2_OP_TSTI:	TSTI(opcode & 0xff);						break;
+	case SH2_OP_ANDI:	ANDI(opcode & 0xff);						break;
+	case SH2_OP_XORI:	XORI(opcode & 0xff);						break;
+	case SH2_OP_ORI:	ORI(opcode & 0xff);							break;
+	case SH2_OP_TSTM:	TSTM(opcode & 0xff);						break;
+	case SH2_OP_ANDM:	ANDM(opcode & 0xff);						break;
+	case SH2_OP_XORM:	XORM(opcode & 0xff);						break;
+	case SH2_OP_ORM:	ORM(opcode & 0xff);							break;
+	case SH2_OP_MOVLI:	MOVLI(opcode & 0xff, Rn);					break;
+	case SH2_OP_MOVI:	MOVI(opcode & 0xff, Rn);					break;
+	}
 }
 
 #endif	// USE_JUMPTABLE
@@ -3218,6 +3528,8 @@ int Sh2Run(int cycles)
 	if (!DebugCPU_SH2Initted) bprintf(PRINT_ERROR, _T("Sh2Run called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SH2);
+
 	sh2->sh2_icount = cycles;
 	sh2->sh2_cycles_to_run = cycles;
 
@@ -3288,6 +3600,8 @@ int Sh2Run(int cycles)
 	if (!DebugCPU_SH2Initted) bprintf(PRINT_ERROR, _T("Sh2Run called without init\n"));
 #endif
 
+	BURN_PROF_SCOPE(BURN_PROF_SH2);
+
 	sh2->sh2_icount = cycles;
 	sh2->sh2_cycles_to_run = cycles;
 	
@@ -3315,25 +3629,7 @@ int Sh2Run(int cycles)
 
 		sh2->ppc = sh2->pc;
 
-		switch (opcode & ( 15 << 12))
-		{
-		case  0<<12: op0000(opcode); break;
-		case  1<<12: op0001(opcode); break;
-		case  2<<12: op0010(opcode); break;
-		case  3<<12: op0011(opcode); break;
-		case  4<<12: op0100(opcode); break;
-		case  5<<12: op0101(opcode); break;
-		case  6<<12: op0110(opcode); break;
-		case  7<<12: op0111(opcode); break;
-		case  8<<12: op1000(opcode); break;
-		case  9<<12: op1001(opcode); break;
-		case 10<<12: op1010(opcode); break;
-		case 11<<12: op1011(opcode); break;
-		case 12<<12: op1100(opcode); break;
-		case 13<<12: op1101(opcode); break;
-		case 14<<12: op1110(opcode); break;
-		default: op1111(opcode); break;
-		}
+		sh2_execute(opcode);
 
 #endif
 
@@ -94,6 +94,7 @@
  *****************************************************************************/
 
 #include "burnint.h"
+#include "burn_idle.h"
 #include "z80.h"
 #include "z80daisy.h"
 
@@ -109,6 +110,13 @@ static Z80WriteProgHandler Z80ProgramWrite;
 static Z80ReadOpHandler Z80CPUReadOp;
 static Z80ReadOpArgHandler Z80CPUReadOpArg;
 
+// Pages of the open cpu (NULL entries go through the handlers)
+static unsigned char *Z80NoMap[0x100];
+static unsigned char **Z80OpMap = Z80NoMap;
+static unsigned char **Z80OpArgMap = Z80NoMap;
+static unsigned char **Z80ReadMap = Z80NoMap;
+static unsigned char **Z80WriteMap = Z80NoMap;
+
 unsigned char Z80Vector = 0;
 
 #define VERBOSE 0
@@ -570,12 +578,18 @@ Z80_INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 /***************************************************************
  * Output a byte to given I/O port
  ***************************************************************/
-#define OUT(port,value) Z80IOWrite(port,value)
+#define OUT(port,value) do { BURN_IDLE_WRITE(); Z80IOWrite(port,value); } while (0)
 
 /***************************************************************
  * Read a byte from given memory location
  ***************************************************************/
-#define RM(addr) (UINT8)Z80ProgramRead(addr)
+Z80_INLINE UINT8 RM(UINT32 addr)
+{
+	unsigned char *page = Z80ReadMap[(addr >> 8) & 0xff];
+	if (page)
+		return page[addr & 0xff];
+	return (UINT8)Z80ProgramRead(addr);
+}
 
 /***************************************************************
  * Read a word from given memory location
@@ -589,7 +603,15 @@ Z80_INLINE void RM16( UINT32 addr, Z80_PAIR *r )
 /***************************************************************
  * Write a byte to given memory location
  ***************************************************************/
-#define WM(addr,value) Z80ProgramWrite(addr,value)
+Z80_INLINE void WM(UINT32 addr, UINT8 value)
+{
+	unsigned char *page = Z80WriteMap[(addr >> 8) & 0xff];
+	BURN_IDLE_WRITE();
+	if (page)
+		page[addr & 0xff] = value;
+	else
+		Z80ProgramWrite(addr, value);
+}
 
 #define cpu_readop(n) Z80CPUReadOp(n)
 #define cpu_readop_arg(n) Z80CPUReadOpArg(n)
@@ -612,6 +634,9 @@ Z80_INLINE UINT8 ROP(void)
 {
 	unsigned pc = PCD;
 	PC++;
+	unsigned char *page = Z80OpMap[pc >> 8];
+	if (page)
+		return page[pc & 0xff];
 	return cpu_readop(pc);
 }
 
@@ -621,18 +646,26 @@ Z80_INLINE UINT8 ROP(void)
  * support systems that use different encoding mechanisms for
  * opcodes and opcode arguments
  ***************************************************************/
+Z80_INLINE UINT8 ARG_AT(unsigned pc)
+{
+	unsigned char *page = Z80OpArgMap[pc >> 8];
+	if (page)
+		return page[pc & 0xff];
+	return cpu_readop_arg(pc);
+}
+
 Z80_INLINE UINT8 ARG(void)
 {
 	unsigned pc = PCD;
 	PC++;
-	return cpu_readop_arg(pc);
+	return ARG_AT(pc);
 }
 
 Z80_INLINE UINT32 ARG16(void)
 {
 	unsigned pc = PCD;
 	PC += 2;
-	return cpu_readop_arg(pc) | (cpu_readop_arg((pc+1)&0xffff) << 8);
+	return ARG_AT(pc) | (ARG_AT((pc+1)&0xffff) << 8);
 }
 
 /***************************************************************
@@ -652,6 +685,18 @@ Z80_INLINE UINT32 ARG16(void)
  ***************************************************************/
 #define PUSH(SR) do { SP -= 2; WM16( SPD, &Z80.SR ); } while (0)
 
+/***************************************************************
+ * Burn the timeslice if a jump back from branch is an idle loop
+ * (see burn_idle.h)
+ ***************************************************************/
+#define IDLE_CHECK(branch)										\
+	if( nBurnIdleActive && (UINT32)((branch) - PCD) <= BURN_IDLE_LOOP_MAX )	\
+	{															\
+		if( Z80.irq_state == Z80_CLEAR_LINE && z80_ICount > 0 &&	\
+			Z80IdleCheck(PCD, branch, &Z80.sp, 7 * sizeof(Z80_PAIR)) )	\
+			z80_ICount = 0;										\
+	}
+
 /***************************************************************
  * JP
  ***************************************************************/
@@ -688,11 +733,14 @@ Z80_INLINE UINT32 ARG16(void)
 					2, cc[Z80_TABLE_op][0x31]+cc[Z80_TABLE_op][0xc3]); \
 		}														\
 	}															\
+	IDLE_CHECK(oldpc);											\
 }
 #else
 #define JP {													\
+	unsigned oldpc = PCD-1;										\
 	PCD = ARG16();												\
 	change_pc(PCD);												\
+	IDLE_CHECK(oldpc);											\
 }
 #endif
 
@@ -703,8 +751,10 @@ Z80_INLINE UINT32 ARG16(void)
 #define JP_COND(cond)											\
 	if( cond )													\
 	{															\
+		unsigned oldpc = PCD-1;									\
 		PCD = ARG16();											\
 		change_pc(PCD);											\
+		IDLE_CHECK(oldpc);										\
 	}															\
 	else														\
 	{															\
@@ -748,6 +798,7 @@ Z80_INLINE UINT32 ARG16(void)
 				   2, cc[Z80_TABLE_op][0x31]+cc[Z80_TABLE_op][0x18]); \
 		}														\
 	}															\
+	IDLE_CHECK(oldpc);											\
 }
 
 /***************************************************************
@@ -756,10 +807,12 @@ Z80_INLINE UINT32 ARG16(void)
 #define JR_COND(cond,opcode)									\
 	if( cond )													\
 	{															\
+		unsigned oldpc = PCD-1;									\
 		INT8 arg = (INT8)ARG(); /* ARG() also increments PC */	\
 		PC += arg;				/* so don't do PC += ARG() */	\
 		CC(ex,opcode);											\
 		change_pc(PCD);											\
+		IDLE_CHECK(oldpc);										\
 	}															\
 	else PC++;													\
 
@@ -3641,6 +3694,21 @@ void Z80SetCPUOpArgReadHandler(Z80ReadOpArgHandler handler)
 	Z80CPUReadOpArg = handler;
 }
 
+// Let ROP()/ARG() read mapped pages directly; the tables are looked at on every
+// fetch, so later changes to them are picked up. NULL means always use the handlers.
+void Z80SetCPUOpMap(unsigned char **opmap, unsigned char **argmap)
+{
+	Z80OpMap = opmap ? opmap : Z80NoMap;
+	Z80OpArgMap = argmap ? argmap : Z80NoMap;
+}
+
+// Same for RM()/WM()
+void Z80SetProgramMap(unsigned char **readmap, unsigned char **writemap)
+{
+	Z80ReadMap = readmap ? readmap : Z80NoMap;
+	Z80WriteMap = writemap ? writemap : Z80NoMap;
+}
+
 int ActiveZ80GetPC()
 {
 	return Z80.pc.w.l;
@@ -85,6 +85,11 @@ void Z80SetProgramReadHandler(Z80ReadProgHandler handler);
 void Z80SetProgramWriteHandler(Z80WriteProgHandler handler);
 void Z80SetCPUOpReadHandler(Z80ReadOpHandler handler);
 void Z80SetCPUOpArgReadHandler(Z80ReadOpArgHandler handler);
+void Z80SetCPUOpMap(unsigned char **opmap, unsigned char **argmap);
+void Z80SetProgramMap(unsigned char **readmap, unsigned char **writemap);
+
+// Implemented by the interface, called on short backward jumps (see burn_idle.h)
+INT32 Z80IdleCheck(UINT32 nHead, UINT32 nBranch, const void* pRegs, INT32 nRegsLen);
 
 int ActiveZ80GetPC();
 int ActiveZ80GetBC();
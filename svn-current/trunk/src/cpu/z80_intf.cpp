@@ -1,5 +1,6 @@
 // Z80 (Zed Eight-Ty) Interface
 #include "burnint.h"
+#include "burn_idle.h"
 #include "z80_intf.h"
 
 #define MAX_Z80		8
@@ -29,6 +30,19 @@ static INT32 nZ80ICount[MAX_Z80];
 static UINT32 Z80EA[MAX_Z80];
 
 static INT32 nOpenedCPU = -1;
+static struct ZetExt * pZetActive = NULL;	// ZetCPUContext[nOpenedCPU], saves an indirection in the handlers
+
+// The cpu whose registers are in the Z80 core. Closing a cpu leaves them there,
+// so they're only copied when a different cpu is opened.
+static INT32 nZetLive = -1;
+
+// Bring ZetCPUContext[]->reg up to date with the live registers
+static void ZetSaveLive()
+{
+	if (nZetLive >= 0) {
+		Z80GetContext(&ZetCPUContext[nZetLive]->reg);
+	}
+}
 static INT32 nCPUCount = 0;
 INT32 nHasZet = -1;
 
@@ -39,25 +53,25 @@ void __fastcall ZetDummyOutHandler(UINT16, UINT8) { }
 
 UINT8 __fastcall ZetReadIO(UINT32 a)
 {
-	return ZetCPUContext[nOpenedCPU]->ZetIn(a);
+	return pZetActive->ZetIn(a);
 }
 
 void __fastcall ZetWriteIO(UINT32 a, UINT8 d)
 {
-	ZetCPUContext[nOpenedCPU]->ZetOut(a, d);
+	pZetActive->ZetOut(a, d);
 }
 
 UINT8 __fastcall ZetReadProg(UINT32 a)
 {
 	// check mem map
-	UINT8 * pr = ZetCPUContext[nOpenedCPU]->pZetMemMap[0x000 | (a >> 8)];
+	UINT8 * pr = pZetActive->pZetMemMap[0x000 | (a >> 8)];
 	if (pr != NULL) {
 		return pr[a & 0xff];
 	}
 	
 	// check handler
-	if (ZetCPUContext[nOpenedCPU]->ZetRead != NULL) {
-		return ZetCPUContext[nOpenedCPU]->ZetRead(a);
+	if (pZetActive->ZetRead != NULL) {
+		return pZetActive->ZetRead(a);
 	}
 	
 	return 0;
@@ -66,15 +80,15 @@ UINT8 __fastcall ZetReadProg(UINT32 a)
 void __fastcall ZetWriteProg(UINT32 a, UINT8 d)
 {
 	// check mem map
-	UINT8 * pr = ZetCPUContext[nOpenedCPU]->pZetMemMap[0x100 | (a >> 8)];
+	UINT8 * pr = pZetActive->pZetMemMap[0x100 | (a >> 8)];
 	if (pr != NULL) {
 		pr[a & 0xff] = d;
 		return;
 	}
 	
 	// check handler
-	if (ZetCPUContext[nOpenedCPU]->ZetWrite != NULL) {
-		ZetCPUContext[nOpenedCPU]->ZetWrite(a, d);
+	if (pZetActive->ZetWrite != NULL) {
+		pZetActive->ZetWrite(a, d);
 		return;
 	}
 }
@@ -82,14 +96,14 @@ void __fastcall ZetWriteProg(UINT32 a, UINT8 d)
 UINT8 __fastcall ZetReadOp(UINT32 a)
 {
 	// check mem map
-	UINT8 * pr = ZetCPUContext[nOpenedCPU]->pZetMemMap[0x200 | (a >> 8)];
+	UINT8 * pr = pZetActive->pZetMemMap[0x200 | (a >> 8)];
 	if (pr != NULL) {
 		return pr[a & 0xff];
 	}
 	
 	// check read handler
-	if (ZetCPUContext[nOpenedCPU]->ZetRead != NULL) {
-		return ZetCPUContext[nOpenedCPU]->ZetRead(a);
+	if (pZetActive->ZetRead != NULL) {
+		return pZetActive->ZetRead(a);
 	}
 	
 	return 0;
@@ -98,19 +112,24 @@ UINT8 __fastcall ZetReadOp(UINT32 a)
 UINT8 __fastcall ZetReadOpArg(UINT32 a)
 {
 	// check mem map
-	UINT8 * pr = ZetCPUContext[nOpenedCPU]->pZetMemMap[0x300 | (a >> 8)];
+	UINT8 * pr = pZetActive->pZetMemMap[0x300 | (a >> 8)];
 	if (pr != NULL) {
 		return pr[a & 0xff];
 	}
 	
 	// check read handler
-	if (ZetCPUContext[nOpenedCPU]->ZetRead != NULL) {
-		return ZetCPUContext[nOpenedCPU]->ZetRead(a);
+	if (pZetActive->ZetRead != NULL) {
+		return pZetActive->ZetRead(a);
 	}
 	
 	return 0;
 }
 
+INT32 Z80IdleCheck(UINT32 nHead, UINT32 nBranch, const void* pRegs, INT32 nRegsLen)
+{
+	return BurnIdleCheck(BURN_IDLE_CPU_Z80 | nOpenedCPU, nHead, nBranch, pRegs, nRegsLen);
+}
+
 void ZetSetReadHandler(UINT8 (__fastcall *pHandler)(UINT16))
 {
 #if defined FBA_DEBUG
@@ -195,6 +214,9 @@ INT32 ZetInit(INT32 nCPU)
 
 	nOpenedCPU = -1;
 
+	ZetSaveLive();
+	nZetLive = -1;
+
 	ZetCPUContext[nCPU] = (struct ZetExt*)BurnMalloc(sizeof(ZetExt));
 	memset (ZetCPUContext[nCPU], 0, sizeof(ZetExt));
 
@@ -328,12 +350,15 @@ void ZetClose()
 	if (nOpenedCPU == -1) bprintf(PRINT_ERROR, _T("ZetClose called when no CPU open\n"));
 #endif
 
-	Z80GetContext(&ZetCPUContext[nOpenedCPU]->reg);
+	// The registers stay live in the core until another cpu is opened (see ZetOpen)
 	nZetCyclesDone[nOpenedCPU] = nZetCyclesTotal;
 	nZ80ICount[nOpenedCPU] = z80_ICount;
 	Z80EA[nOpenedCPU] = EA;
+	Z80SetProgramMap(NULL, NULL);
+	Z80SetCPUOpMap(NULL, NULL);
 
 	nOpenedCPU = -1;
+	pZetActive = NULL;
 }
 
 void ZetOpen(INT32 nCPU)
@@ -345,12 +370,19 @@ void ZetOpen(INT32 nCPU)
 	if (ZetCPUContext[nCPU] == NULL) bprintf (PRINT_ERROR, _T("ZetOpen called for uninitialized cpu %x\n"), nCPU);
 #endif
 
-	Z80SetContext(&ZetCPUContext[nCPU]->reg);
+	if (nCPU != nZetLive) {
+		ZetSaveLive();
+		Z80SetContext(&ZetCPUContext[nCPU]->reg);
+		nZetLive = nCPU;
+	}
+	Z80SetProgramMap(ZetCPUContext[nCPU]->pZetMemMap + 0x000, ZetCPUContext[nCPU]->pZetMemMap + 0x100);
+	Z80SetCPUOpMap(ZetCPUContext[nCPU]->pZetMemMap + 0x200, ZetCPUContext[nCPU]->pZetMemMap + 0x300);
 	nZetCyclesTotal = nZetCyclesDone[nCPU];
 	z80_ICount = nZ80ICount[nCPU];
 	EA = Z80EA[nCPU];
 
 	nOpenedCPU = nCPU;
+	pZetActive = ZetCPUContext[nCPU];
 }
 
 INT32 ZetGetActive()
@@ -371,6 +403,8 @@ INT32 ZetRun(INT32 nCycles)
 #endif
 
 	if (nCycles <= 0) return 0;
+
+	BURN_PROF_SCOPE(BURN_PROF_Z80);
 	
 	if (ZetCPUContext[nOpenedCPU]->BusReq) {
 		nZetCyclesTotal += nCycles;
@@ -436,6 +470,10 @@ void ZetExit()
 #endif
 
 	Z80Exit();
+	Z80SetProgramMap(NULL, NULL);
+	Z80SetCPUOpMap(NULL, NULL);
+	pZetActive = NULL;
+	nZetLive = -1;
 
 	for (INT32 i = 0; i < MAX_Z80; i++) {
 		if (ZetCPUContext[i]) {
@@ -561,7 +599,7 @@ INT32 ZetGetPC(INT32 n)
 	if (nOpenedCPU == -1 && n < 0) bprintf(PRINT_ERROR, _T("ZetGetPC called when no CPU open\n"));
 #endif
 
-	if (n < 0) {
+	if (n < 0 || n == nZetLive) {
 		return ActiveZ80GetPC();
 	} else {
 		return ZetCPUContext[n]->reg.pc.w.l;
@@ -575,7 +613,7 @@ INT32 ZetBc(INT32 n)
 	if (nOpenedCPU == -1 && n < 0) bprintf(PRINT_ERROR, _T("ZetBc called when no CPU open\n"));
 #endif
 
-	if (n < 0) {
+	if (n < 0 || n == nZetLive) {
 		return ActiveZ80GetBC();
 	} else {
 		return ZetCPUContext[n]->reg.bc.w.l;
@@ -589,7 +627,7 @@ INT32 ZetDe(INT32 n)
 	if (nOpenedCPU == -1 && n < 0) bprintf(PRINT_ERROR, _T("ZetDe called when no CPU open\n"));
 #endif
 
-	if (n < 0) {
+	if (n < 0 || n == nZetLive) {
 		return ActiveZ80GetDE();
 	} else {
 		return ZetCPUContext[n]->reg.de.w.l;
@@ -603,7 +641,7 @@ INT32 ZetHL(INT32 n)
 	if (nOpenedCPU == -1 && n < 0) bprintf(PRINT_ERROR, _T("ZetHL called when no CPU open\n"));
 #endif
 
-	if (n < 0) {
+	if (n < 0 || n == nZetLive) {
 		return ActiveZ80GetHL();
 	} else {
 		return ZetCPUContext[n]->reg.hl.w.l;
@@ -621,6 +659,11 @@ INT32 ZetScan(INT32 nAction)
 	}
 
 	char szText[] = "Z80 #0";
+
+	ZetSaveLive();
+	if ((nAction & ACB_WRITE) && nOpenedCPU < 0) {
+		nZetLive = -1;		// Load the new registers on the next open
+	}
 	
 	for (INT32 i = 0; i < nCPUCount; i++) {
 		szText[5] = '1' + i;
@@ -741,6 +784,10 @@ void ZetSetBUSREQLine(INT32 nStatus)
 
 void ZetSetHL(INT32 n, UINT16 value)
 {
+	ZetSaveLive();
+	if (n == nZetLive && n != nOpenedCPU) {
+		nZetLive = -1;
+	}
 	ZetCPUContext[n]->reg.sp.w.l=value;
 }
 